@@ -0,0 +1,137 @@
+/**
+ * @file AiMove.h
+ * @brief Move selection of the firmware AI: the move table, then the search.
+ *
+ * A game can also be played at another tier, where the reply comes from a
+ * budgeted engine instead: the alpha-beta of BoardSearch.h or the Monte
+ * Carlo search of Mcts.h, both stopped by AI_TIER_LIMITS. Whichever of the
+ * node (playout) budget and the time budget runs out first ends the search,
+ * so on a slow board a reply can depend on timing.
+ *
+ * The client includes this header too and predicts the AI's reply with the
+ * same code the board runs (see lib/client/MovePredictor.h), at TIER_NORMAL
+ * only, the one tier whose reply never depends on timing.
+ */
+#ifndef AI_MOVE_H
+#define AI_MOVE_H
+
+#include <stdint.h>
+#include <string.h>
+#include "BitBoard.h"
+#include "MoveTable.h"
+#include "Search.h"
+#include "Board.h"
+#include "BoardSearch.h"
+#include "Mcts.h"
+
+/**
+ * @enum AiTier
+ * @brief Difficulty and reply budget of the AI, chosen per game.
+ */
+enum AiTier : uint8_t {
+    TIER_NORMAL = 0, ///< Move table, then the full minimax: the original AI.
+    TIER_HARD = 1,   ///< Alpha-beta (BoardSearch) within AI_TIER_LIMITS[TIER_HARD].
+    TIER_EASY = 2    ///< Monte Carlo tree search (MctsSearch) within AI_TIER_LIMITS[TIER_EASY].
+};
+
+/// Number of AiTier values.
+const uint8_t AI_TIER_COUNT = 3;
+
+#if !defined(__AVR__) && !defined(memcpy_P)
+#define memcpy_P(destination, source, size) memcpy((destination), (source), (size))
+#endif
+
+/// Budgets of the tiers, in flash; TIER_NORMAL has none.
+const SearchLimits AI_TIER_LIMITS[AI_TIER_COUNT] PROGMEM = {
+    {0, 0, 0},
+    {2, 60, 10000UL},
+    {0, 16, 10000UL}
+};
+
+/// Nodes of the TIER_EASY tree, 8 bytes each.
+const uint16_t AI_MCTS_POOL = 32;
+
+/// Names of the tiers, also their text commands; in flash, so the firmware reads them with tierName().
+const char AI_TIER_NAME_NORMAL[] PROGMEM = "normal";
+const char AI_TIER_NAME_HARD[] PROGMEM = "hard";
+const char AI_TIER_NAME_EASY[] PROGMEM = "easy";
+const char* const AI_TIER_NAMES[AI_TIER_COUNT] PROGMEM = { AI_TIER_NAME_NORMAL, AI_TIER_NAME_HARD, AI_TIER_NAME_EASY };
+
+/// @return The budget of a tier, read from AI_TIER_LIMITS.
+inline SearchLimits tierLimits(uint8_t tier) {
+    SearchLimits limits;
+    memcpy_P(&limits, &AI_TIER_LIMITS[tier], sizeof(limits));
+    return limits;
+}
+
+/// @return The name of a tier, a PROGMEM string (read from AI_TIER_NAMES).
+inline const char* tierName(uint8_t tier) {
+    const char* name;
+    memcpy_P(&name, &AI_TIER_NAMES[tier], sizeof(name));
+    return name;
+}
+
+/// @return The alpha-beta of TIER_HARD, allocated once.
+inline BoardSearch<3, 3>& tierAlphaBeta() {
+    static BoardSearch<3, 3> search;
+    return search;
+}
+
+/// @return The Monte Carlo search of TIER_EASY, allocated once.
+inline MctsSearch<3, 3, AI_MCTS_POOL>& tierMonteCarlo() {
+    static MctsSearch<3, 3, AI_MCTS_POOL> search;
+    return search;
+}
+
+/**
+ * @brief Looks up the AI's reply in the precomputed move table.
+ * @param b The position, with the AI to move.
+ * @return Cell index 0..8, or -1 if the position is not in the table.
+ */
+inline int8_t lookupBestMove(BitBoard b) {
+    int16_t index = positionIndex(b);
+    if (index < 0) return -1;
+    uint8_t packed = pgm_read_byte(&MOVE_TABLE[index >> 1]);
+    uint8_t cell = (index & 1) ? (packed >> 4) : (packed & 0x0F);
+    return cell == NO_TABLE_MOVE ? -1 : cell;
+}
+
+/**
+ * @brief Searches a position within the budget of TIER_HARD or TIER_EASY.
+ * The search objects are allocated once; the move ordering history is
+ * cleared first, so equal positions get equal replies unless the time
+ * budget cuts a search short.
+ * @param b The position, with the AI to move.
+ * @param tier TIER_HARD or TIER_EASY.
+ * @return Cell index 0..8, or -1 if the board is full.
+ */
+inline int8_t budgetedAiMove(BitBoard b, uint8_t tier) {
+    char cells[9];
+    for (uint8_t i = 0; i < 9; i++) {
+        cells[i] = (b.ai >> i & 1) ? 'O' : (b.player >> i & 1) ? 'X' : ' ';
+    }
+    Board<3, 3> board;
+    board.load(cells, MARK_O);
+    if (tier == TIER_HARD) {
+        tierAlphaBeta().clearHistory();
+        return (int8_t)tierAlphaBeta().findBestMove(board, tierLimits(TIER_HARD)).move;
+    }
+    return (int8_t)tierMonteCarlo().findBestMove(board, tierLimits(TIER_EASY)).move;
+}
+
+/**
+ * @brief Chooses the AI's reply.
+ * At TIER_NORMAL takes the reply from the move table and falls back to the
+ * minimax search for positions the table does not cover.
+ * @param b The position, with the AI to move.
+ * @param tier AiTier of the game.
+ * @return Cell index 0..8, or -1 if the board is full.
+ */
+inline int8_t chooseAiMove(BitBoard b, uint8_t tier = TIER_NORMAL) {
+    if (tier == TIER_HARD || tier == TIER_EASY) return budgetedAiMove(b, tier);
+    int8_t cell = lookupBestMove(b);
+    if (cell < 0) cell = bbFindBestMove(b);
+    return cell;
+}
+
+#endif // AI_MOVE_H
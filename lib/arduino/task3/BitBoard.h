@@ -0,0 +1,194 @@
+/**
+ * @file BitBoard.h
+ * @brief Bitboard representation of the Tic-Tac-Toe board used by the AI.
+ *
+ * A position is two 9-bit masks, one per side. Cell (row, col) maps to bit
+ * row * 3 + col, so walking the bits from low to high visits the cells in the
+ * same row-major order as the char[3][3] loops in task3.ino. Placing a mark is
+ * a single OR on a copy, so the search never has to undo moves.
+ */
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#endif
+#endif
+
+/// Mask with all nine cells set.
+const uint16_t FULL_BOARD = 0x1FF;
+
+/// Number of winning lines on a 3x3 board.
+const uint8_t WIN_LINE_COUNT = 8;
+
+/// Winning lines in the order evaluate() checks them: row i, column i for i = 0..2, then both diagonals.
+const uint16_t WIN_LINES[WIN_LINE_COUNT] = {
+    0x007, 0x049, // row 0, column 0
+    0x038, 0x092, // row 1, column 1
+    0x1C0, 0x124, // row 2, column 2
+    0x111, 0x054  // main diagonal, anti-diagonal
+};
+
+/// Static priority of each cell (centre > corners > edges), used to break ties between equal moves.
+const uint8_t POSITION_PRIORITY[9] = {
+    3, 2, 3,
+    2, 4, 2,
+    3, 2, 3
+};
+
+/**
+ * @struct BitBoard
+ * @brief Game position stored as one occupancy mask per side.
+ */
+struct BitBoard {
+    uint16_t ai;     ///< Cells taken by the AI.
+    uint16_t player; ///< Cells taken by the human player.
+};
+
+/**
+ * @brief Counts the set bits of a mask.
+ * @param mask Cell mask.
+ * @return Number of cells in the mask.
+ */
+inline uint8_t bitCount(uint16_t mask) {
+    return __builtin_popcount(mask);
+}
+
+/**
+ * @brief Returns the index of the lowest set bit, i.e. the first cell in row-major order.
+ * @param mask Cell mask.
+ * @return Cell index 0..8, or -1 if the mask is empty.
+ */
+inline int8_t firstCell(uint16_t mask) {
+    return mask ? (int8_t)__builtin_ctz(mask) : -1;
+}
+
+/**
+ * @brief Returns the empty cells of a position.
+ * @param b The position.
+ * @return Mask of free cells.
+ */
+inline uint16_t bbEmpty(BitBoard b) {
+    return ~(b.ai | b.player) & FULL_BOARD;
+}
+
+/**
+ * @brief Places a mark on a copy of the position.
+ * @param b The position.
+ * @param aiMoves True to place an AI mark, false to place a player mark.
+ * @param cell Cell index 0..8.
+ * @return The new position.
+ */
+inline BitBoard bbPlace(BitBoard b, bool aiMoves, uint8_t cell) {
+    uint16_t bit = (uint16_t)1 << cell;
+    if (aiMoves) b.ai |= bit;
+    else b.player |= bit;
+    return b;
+}
+
+/**
+ * @brief Evaluates the position.
+ * @param b The position.
+ * @return 1 if the AI owns the first complete line, -1 if the player does, 0 otherwise.
+ */
+inline int8_t bbEvaluate(BitBoard b) {
+    for (uint8_t i = 0; i < WIN_LINE_COUNT; i++) {
+        uint16_t line = WIN_LINES[i];
+        if ((b.ai & line) == line) return 1;
+        if ((b.player & line) == line) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Bitboard counterpart of isMovesLeft().
+ * Keeps the return convention of the char[3][3] version (true only once every
+ * cell is taken), so minimax() scores positions exactly as it always has.
+ * @param b The position.
+ * @return True if the board is full, false otherwise.
+ */
+inline bool bbIsMovesLeft(BitBoard b) {
+    return bbEmpty(b) == 0;
+}
+
+/**
+ * @brief Finds the empty cells that would complete a line for one side.
+ * A line is a threat when the side holds two of its cells and the opponent none.
+ * @param own Cells of the side to move.
+ * @param opponent Cells of the other side.
+ * @return Mask of cells that win immediately.
+ */
+inline uint16_t bbThreats(uint16_t own, uint16_t opponent) {
+    uint16_t threats = 0;
+    for (uint8_t i = 0; i < WIN_LINE_COUNT; i++) {
+        uint16_t line = WIN_LINES[i];
+        if ((opponent & line) == 0 && bitCount(own & line) == 2) {
+            threats |= line & ~own;
+        }
+    }
+    return threats;
+}
+
+/**
+ * @brief Collects the empty cells where a mark makes bbEvaluate() return a given score.
+ * On an undecided board only a freshly completed line can change the score, so
+ * the answer is the threat mask. Boards that already hold a line are probed
+ * cell by cell to keep the first-line-wins ordering of bbEvaluate().
+ * @param b The position.
+ * @param aiMoves True if the AI places the mark, false for the player.
+ * @param target Score to look for (1 or -1).
+ * @return Mask of matching cells.
+ */
+inline uint16_t bbCellsScoring(BitBoard b, bool aiMoves, int8_t target) {
+    if (bbEvaluate(b) == 0) {
+        if (target != (aiMoves ? 1 : -1)) return 0;
+        return aiMoves ? bbThreats(b.ai, b.player) : bbThreats(b.player, b.ai);
+    }
+    uint16_t cells = 0;
+    for (uint16_t empty = bbEmpty(b); empty; empty &= empty - 1) {
+        uint8_t cell = firstCell(empty);
+        if (bbEvaluate(bbPlace(b, aiMoves, cell)) == target) {
+            cells |= (uint16_t)1 << cell;
+        }
+    }
+    return cells;
+}
+
+/**
+ * @brief Checks if a side can create a fork (two winning moves).
+ * @param b The position.
+ * @param aiMoves True to check the AI, false to check the player.
+ * @return True if at least two cells win immediately.
+ */
+inline bool bbCanCreateFork(BitBoard b, bool aiMoves) {
+    return bitCount(bbCellsScoring(b, aiMoves, aiMoves ? 1 : -1)) >= 2;
+}
+
+/**
+ * @brief Finds the first move that leaves a side with a fork.
+ * @param b The position.
+ * @param aiMoves True to search for the AI, false for the player.
+ * @return Cell index, or -1 if none found.
+ */
+inline int8_t bbFindForkMove(BitBoard b, bool aiMoves) {
+    for (uint16_t empty = bbEmpty(b); empty; empty &= empty - 1) {
+        uint8_t cell = firstCell(empty);
+        if (bbCanCreateFork(bbPlace(b, aiMoves, cell), aiMoves)) {
+            return cell;
+        }
+    }
+    return -1;
+}
+
+#endif // BITBOARD_H
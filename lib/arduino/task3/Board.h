@@ -0,0 +1,292 @@
+/**
+ * @file Board.h
+ * @brief Generalized N x N, K-in-a-row board with incremental line counters.
+ *
+ * Every run of K cells in a row, column or diagonal is a window. The board
+ * keeps a per-side mark count for each window, so a move only touches the
+ * (at most 4 * K) windows through its cell: win detection and the heuristic
+ * score are updated in O(K) instead of rescanning the board. Board<3, 3> is
+ * the classic game; the header has no heap or STL use so it also builds for AVR.
+ */
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+
+/**
+ * @enum Mark
+ * @brief Content of a cell, also used to name a side.
+ */
+enum Mark : uint8_t {
+    MARK_NONE = 0, ///< Empty cell / no side.
+    MARK_X = 1,    ///< Player X.
+    MARK_O = 2     ///< Player O.
+};
+
+/**
+ * @brief Returns the other side.
+ * @param side MARK_X or MARK_O.
+ * @return The opponent of side.
+ */
+inline Mark opponentOf(Mark side) {
+    return side == MARK_X ? MARK_O : MARK_X;
+}
+
+/**
+ * @brief Heuristic weight of a window holding count marks of a single side.
+ * @param count Marks in the window.
+ * @return 0 for an empty window, growing by 4x per extra mark.
+ */
+inline int32_t windowWeight(uint8_t count) {
+    if (count == 0) return 0;
+    return (int32_t)1 << (count < 12 ? 2 * count : 24);
+}
+
+/**
+ * @class Board
+ * @brief N x N board where K marks in a row win.
+ * @tparam N Board side (at most 15).
+ * @tparam K Marks in a row needed to win (K <= N).
+ */
+template <uint8_t N, uint8_t K>
+class Board {
+public:
+    enum {
+        CELLS = N * N,                            ///< Number of cells.
+        SPAN = N - K + 1,                         ///< Window start positions along one axis.
+        HORIZONTAL = N * SPAN,                    ///< Windows per straight direction.
+        DIAGONAL = SPAN * SPAN,                   ///< Windows per diagonal direction.
+        WINDOWS = 2 * HORIZONTAL + 2 * DIAGONAL,  ///< Total number of windows.
+        MAX_CELL_WINDOWS = 4 * K                  ///< Upper bound on windows through one cell.
+    };
+
+    static_assert(K >= 1 && K <= N, "K must be between 1 and N");
+    static_assert(N * N <= 255, "cell indices must fit in uint8_t");
+
+    /**
+     * @brief Creates an empty board with X to move.
+     */
+    Board() {
+        clear(MARK_X);
+    }
+
+    /**
+     * @brief Empties the board.
+     * @param first Side that moves first.
+     */
+    void clear(Mark first) {
+        for (uint8_t i = 0; i < CELLS; i++) cells[i] = MARK_NONE;
+        for (uint16_t w = 0; w < WINDOWS; w++) {
+            counts[0][w] = 0;
+            counts[1][w] = 0;
+        }
+        score = 0;
+        marks = 0;
+        toMove = first;
+        winningSide = MARK_NONE;
+    }
+
+    /**
+     * @brief Loads a position from a row-major character array.
+     * @param source CELLS characters: 'X', 'O' or anything else for empty.
+     * @param sideToMove Side to move in the loaded position.
+     */
+    void load(const char* source, Mark sideToMove) {
+        clear(sideToMove);
+        for (uint8_t i = 0; i < CELLS; i++) {
+            if (source[i] == 'X') setMark(i, MARK_X);
+            else if (source[i] == 'O') setMark(i, MARK_O);
+        }
+    }
+
+    /**
+     * @brief Places the mark of the side to move and passes the turn.
+     * @param cell Empty cell index.
+     * @return True if the move completes a window.
+     */
+    bool place(uint8_t cell) {
+        setMark(cell, toMove);
+        toMove = opponentOf(toMove);
+        return winningSide != MARK_NONE;
+    }
+
+    /**
+     * @brief Takes back the mark on a cell and returns the turn to its owner.
+     * @param cell Occupied cell index.
+     */
+    void undo(uint8_t cell) {
+        toMove = (Mark)cells[cell];
+        clearMark(cell);
+    }
+
+    /// @return Content of a cell.
+    Mark at(uint8_t cell) const { return (Mark)cells[cell]; }
+    /// @return Side to move.
+    Mark sideToMove() const { return toMove; }
+    /// @return Side owning a complete window, or MARK_NONE.
+    Mark winner() const { return winningSide; }
+    /// @return Number of marks on the board.
+    uint8_t markCount() const { return marks; }
+    /// @return True if every cell is taken.
+    bool isFull() const { return marks == CELLS; }
+
+    /**
+     * @brief Heuristic score of a non-terminal position.
+     * Sum over windows held by only one side of windowWeight(marks).
+     * @return Score from the point of view of the side to move.
+     */
+    int32_t evaluate() const {
+        return toMove == MARK_X ? score : -score;
+    }
+
+    /**
+     * @brief Lists the windows that contain a cell.
+     * @param cell Cell index.
+     * @param out Array of at least MAX_CELL_WINDOWS entries.
+     * @return Number of windows written.
+     */
+    uint8_t windowsThrough(uint8_t cell, uint16_t* out) const {
+        int8_t r = cell / N;
+        int8_t c = cell % N;
+        uint8_t n = 0;
+        for (int8_t t = 0; t < K; t++) {
+            int8_t c0 = c - t;
+            if (c0 >= 0 && c0 < SPAN) out[n++] = r * SPAN + c0;
+            int8_t r0 = r - t;
+            if (r0 >= 0 && r0 < SPAN) out[n++] = HORIZONTAL + r0 * N + c;
+            if (r0 >= 0 && r0 < SPAN && c0 >= 0 && c0 < SPAN) {
+                out[n++] = 2 * HORIZONTAL + r0 * SPAN + c0;
+            }
+            int8_t c1 = c + t;
+            if (r0 >= 0 && r0 < SPAN && c1 >= K - 1 && c1 < N) {
+                out[n++] = 2 * HORIZONTAL + DIAGONAL + r0 * SPAN + (c1 - (K - 1));
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief Static priority of a cell: the number of windows through it.
+     * On 3 x 3 this gives the firmware's centre 4 / corner 3 / edge 2 table.
+     * @param cell Cell index.
+     * @return Number of windows containing the cell.
+     */
+    uint8_t priority(uint8_t cell) const {
+        uint16_t ids[MAX_CELL_WINDOWS];
+        return windowsThrough(cell, ids);
+    }
+
+    /**
+     * @brief Checks if a mark on an empty cell would complete a window.
+     * @param cell Empty cell index.
+     * @param side Side placing the mark.
+     * @return True if the move wins.
+     */
+    bool winsAt(uint8_t cell, Mark side) const {
+        uint16_t ids[MAX_CELL_WINDOWS];
+        uint8_t n = windowsThrough(cell, ids);
+        for (uint8_t i = 0; i < n; i++) {
+            if (counts[side - 1][ids[i]] == K - 1 && counts[2 - side][ids[i]] == 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Finds the first winning cell in row-major order.
+     * @param side Side to check.
+     * @return Cell index, or -1 if the side has no immediate win.
+     */
+    int16_t firstWinningCell(Mark side) const {
+        for (uint8_t i = 0; i < CELLS; i++) {
+            if (cells[i] == MARK_NONE && winsAt(i, side)) return i;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Checks if a side has two or more distinct winning cells.
+     * @param side Side to check.
+     * @return True if the side has a fork on the board.
+     */
+    bool hasFork(Mark side) const {
+        uint8_t found = 0;
+        for (uint8_t i = 0; i < CELLS; i++) {
+            if (cells[i] == MARK_NONE && winsAt(i, side) && ++found >= 2) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Finds the first move that leaves a side with a fork.
+     * @param side Side to move.
+     * @return Cell index, or -1 if none found.
+     */
+    int16_t findForkMove(Mark side) {
+        for (uint8_t i = 0; i < CELLS; i++) {
+            if (cells[i] != MARK_NONE) continue;
+            setMark(i, side);
+            bool fork = winningSide == MARK_NONE && hasFork(side);
+            clearMark(i);
+            if (fork) return i;
+        }
+        return -1;
+    }
+
+private:
+    /**
+     * @brief Heuristic contribution of one window.
+     * @param w Window index.
+     * @return Contribution from X's point of view.
+     */
+    int32_t windowScore(uint16_t w) const {
+        uint8_t x = counts[0][w];
+        uint8_t o = counts[1][w];
+        if (x != 0 && o != 0) return 0;
+        return windowWeight(x) - windowWeight(o);
+    }
+
+    /**
+     * @brief Puts a mark on a cell and updates the window counters.
+     * @param cell Empty cell index.
+     * @param side Owner of the mark.
+     */
+    void setMark(uint8_t cell, Mark side) {
+        uint16_t ids[MAX_CELL_WINDOWS];
+        uint8_t n = windowsThrough(cell, ids);
+        for (uint8_t i = 0; i < n; i++) {
+            uint16_t w = ids[i];
+            score -= windowScore(w);
+            if (++counts[side - 1][w] == K) winningSide = side;
+            score += windowScore(w);
+        }
+        cells[cell] = side;
+        marks++;
+    }
+
+    /**
+     * @brief Removes a mark from a cell and updates the window counters.
+     * @param cell Occupied cell index.
+     */
+    void clearMark(uint8_t cell) {
+        Mark side = (Mark)cells[cell];
+        uint16_t ids[MAX_CELL_WINDOWS];
+        uint8_t n = windowsThrough(cell, ids);
+        for (uint8_t i = 0; i < n; i++) {
+            uint16_t w = ids[i];
+            score -= windowScore(w);
+            if (counts[side - 1][w]-- == K) winningSide = MARK_NONE;
+            score += windowScore(w);
+        }
+        cells[cell] = MARK_NONE;
+        marks--;
+    }
+
+    uint8_t cells[CELLS];          ///< Row-major cell contents (Mark values).
+    uint8_t counts[2][WINDOWS];    ///< Marks of X (row 0) and O (row 1) in each window.
+    int32_t score;                 ///< Heuristic score from X's point of view.
+    uint8_t marks;                 ///< Number of marks on the board.
+    Mark toMove;                   ///< Side to move.
+    Mark winningSide;              ///< Side that completed a window, if any.
+};
+
+#endif // BOARD_H
@@ -0,0 +1,431 @@
+/**
+ * @file BoardSearch.h
+ * @brief Iterative-deepening alpha-beta search for Board<N, K>.
+ *
+ * Move selection follows the firmware engine: take an immediate win, block
+ * the opponent's immediate win, create a fork, and only then search. The
+ * search is a negamax alpha-beta with killer and history move ordering,
+ * deepened one ply at a time until the depth, node or time budget runs out;
+ * the last fully searched depth decides, unless the interrupted iteration
+ * already found a better root move than the previous best (which it searches
+ * first). So the search is anytime: it always returns the best move found so
+ * far. Equal scores go to the cell with the higher priority(), then to the
+ * first cell in row-major order. On 3 x 3 the inner nodes go through the
+ * symmetry-canonical transposition table of Transposition.h, which is
+ * cleared at every call so equal positions get equal replies.
+ */
+#ifndef BOARD_SEARCH_H
+#define BOARD_SEARCH_H
+
+#include <stdint.h>
+#include "Board.h"
+#include "Transposition.h"
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * @brief Clock of the search time budgets.
+ * @return Microseconds since an arbitrary origin; wraps like micros().
+ */
+inline uint32_t searchMicros() {
+#ifdef ARDUINO
+    return micros();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/// Score of a won position (minus the distance to the win).
+const int32_t WIN_SCORE = 1000000000L;
+
+/**
+ * @struct SearchLimits
+ * @brief Budget of one findBestMove() call.
+ */
+struct SearchLimits {
+    uint8_t maxDepth;   ///< Deepest iteration in plies; 0 = tactics and priority only.
+    uint32_t maxNodes;  ///< Node budget (playouts for MctsSearch), 0 for unlimited.
+    uint32_t maxMicros; ///< Time budget in microseconds, 0 for unlimited.
+};
+
+/// Reproduces the original firmware engine on 3 x 3: its minimax scores every open position as 0.
+const SearchLimits LEGACY_SEARCH = {0, 0, 0};
+
+/// Default budget for larger boards.
+const SearchLimits DEFAULT_SEARCH = {64, 200000UL, 0};
+
+/**
+ * @struct SearchResult
+ * @brief Outcome of findBestMove().
+ */
+struct SearchResult {
+    int16_t move;   ///< Chosen cell, or -1 if the board is full.
+    int32_t value;  ///< Score of the move for the side to move.
+    uint8_t depth;  ///< Deepest completed iteration (0 for tactical moves).
+    uint32_t nodes; ///< Nodes searched.
+};
+
+/**
+ * @brief Key of a position in the transposition table.
+ * Only 3 x 3 boards have one; other sizes search without the table.
+ * @return False if the position has no key.
+ */
+template <uint8_t N, uint8_t K>
+inline bool transpositionKey(const Board<N, K>&, uint32_t&) {
+    return false;
+}
+
+/**
+ * @brief Symmetry-canonical key of a 3 x 3 position, with O as the AI side as in the firmware.
+ * @return True.
+ */
+inline bool transpositionKey(const Board<3, 3>& board, uint32_t& key) {
+    BitBoard b = {0, 0};
+    for (uint8_t i = 0; i < 9; i++) {
+        if (board.at(i) == MARK_O) b.ai |= (uint16_t)1 << i;
+        else if (board.at(i) == MARK_X) b.player |= (uint16_t)1 << i;
+    }
+    key = canonicalKey(b, board.sideToMove() == MARK_O);
+    return true;
+}
+
+/**
+ * @class BoardSearch
+ * @brief Search state (move ordering tables and counters) for one board type.
+ * @tparam N Board side.
+ * @tparam K Marks in a row needed to win.
+ */
+template <uint8_t N, uint8_t K>
+class BoardSearch {
+public:
+    typedef Board<N, K> BoardType;
+
+    enum {
+        CELLS = BoardType::CELLS,
+        MAX_PLY = BoardType::CELLS + 1,
+        NO_MOVE = 0xFF,
+        NEIGHBOURHOOD = 2, ///< Inner nodes only try cells within this distance of a mark.
+        CLOCK_INTERVAL = 32 ///< Nodes between two looks at the clock.
+    };
+
+    /// History scores stay below this, so the ordering key (history << 6) never reaches the killer bits.
+    static const uint32_t HISTORY_LIMIT = 1UL << 23;
+
+    BoardSearch() {
+        clearHistory();
+    }
+
+    /**
+     * @brief Forgets killer moves and history scores.
+     */
+    void clearHistory() {
+        for (uint8_t p = 0; p < MAX_PLY; p++) {
+            killers[p][0] = NO_MOVE;
+            killers[p][1] = NO_MOVE;
+        }
+        for (uint8_t i = 0; i < CELLS; i++) {
+            history[0][i] = 0;
+            history[1][i] = 0;
+        }
+    }
+
+    /**
+     * @brief Finds the best move for the side to move.
+     * @param board The position; restored before returning.
+     * @param limits Depth, node and time budget.
+     * @return The chosen move and search statistics.
+     */
+    SearchResult findBestMove(BoardType& board, SearchLimits limits) {
+        SearchResult result = {-1, 0, 0, 0};
+        nodes = 0;
+        aborted = false;
+        nodeLimit = limits.maxNodes;
+        timeLimit = limits.maxMicros;
+        started = searchMicros();
+        if (board.isFull()) return result;
+        uint32_t key;
+        if (transpositionKey(board, key)) clearTranspositionTable();
+
+        result.move = tacticalMove(board);
+        if (result.move >= 0) return result;
+        result.move = priorityMove(board);
+        if (limits.maxDepth == 0) return result;
+
+        uint8_t moves[CELLS];
+        uint8_t count = generateMoves(board, moves);
+        uint8_t empty = CELLS - board.markCount();
+        for (uint8_t depth = 1; depth <= limits.maxDepth; depth++) {
+            int16_t bestMove = -1;
+            int32_t best = -WIN_SCORE - 1;
+            for (uint8_t i = 0; i < count; i++) {
+                uint8_t move = moves[i];
+                int32_t alpha = (bestMove < 0) ? -WIN_SCORE - 1 : best - 1;
+                board.place(move);
+                int32_t value = -alphaBeta(board, depth - 1, 1, -WIN_SCORE - 1, -alpha);
+                board.undo(move);
+                if (aborted) break;
+                if (bestMove < 0 || isBetter(board, value, move, best, bestMove)) {
+                    best = value;
+                    bestMove = move;
+                }
+            }
+            if (aborted) {
+                // The previous best went first; a move that beat it is better at this depth too.
+                if (bestMove >= 0 && bestMove != moves[0] && result.depth > 0) {
+                    result.move = bestMove;
+                    result.value = best;
+                }
+                break;
+            }
+
+            result.move = bestMove;
+            result.value = best;
+            result.depth = depth;
+            moveToFront(moves, count, bestMove);
+            if (best >= WIN_SCORE - MAX_PLY || best <= -WIN_SCORE + MAX_PLY) break;
+            if (depth >= empty) break;
+        }
+        result.nodes = nodes;
+        return result;
+    }
+
+protected:
+    /**
+     * @brief Negamax alpha-beta.
+     * @param board The position.
+     * @param depth Remaining depth.
+     * @param ply Distance from the root.
+     * @param alpha Lower bound.
+     * @param beta Upper bound.
+     * @return Score for the side to move.
+     */
+    int32_t alphaBeta(BoardType& board, uint8_t depth, uint8_t ply, int32_t alpha, int32_t beta) {
+        if ((nodeLimit != 0 && nodes >= nodeLimit) || (timeLimit != 0 && nodes % CLOCK_INTERVAL == 0 &&
+                                                        searchMicros() - started >= timeLimit)) {
+            aborted = true;
+            return 0;
+        }
+        nodes++;
+        if (board.winner() != MARK_NONE) return -(WIN_SCORE - ply);
+        if (board.isFull()) return 0;
+        if (depth == 0) return board.evaluate();
+
+        uint32_t key = 0;
+        TTEntry* entry = 0;
+        int32_t originalAlpha = alpha;
+        if (ttEnabled && transpositionKey(board, key)) {
+            entry = &ttSlot(key);
+            searchStats.ttProbes++;
+            if (entry->flag != TT_EMPTY && entry->key == key && entry->depth >= depth) {
+                int32_t value = fromTable(entry->value, ply);
+                if (entry->flag == TT_EXACT
+                    || (entry->flag == TT_LOWER && value >= beta)
+                    || (entry->flag == TT_UPPER && value <= alpha)) {
+                    searchStats.ttHits++;
+                    return value;
+                }
+            }
+        }
+
+        uint8_t moves[CELLS];
+        uint8_t count = generateMoves(board, moves);
+        orderMoves(board, ply, moves, count);
+
+        Mark side = board.sideToMove();
+        int32_t best = -WIN_SCORE - 1;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t move = moves[i];
+            board.place(move);
+            int32_t value = -alphaBeta(board, depth - 1, ply + 1, -beta, -alpha);
+            board.undo(move);
+            if (aborted) return 0;
+            if (value > best) best = value;
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) {
+                if (killers[ply][0] != move) {
+                    killers[ply][1] = killers[ply][0];
+                    killers[ply][0] = move;
+                }
+                addHistory(side, move, depth);
+                break;
+            }
+        }
+
+        if (entry != 0) {
+            entry->key = key;
+            entry->value = toTable(best, ply);
+            entry->depth = depth;
+            if (best <= originalAlpha) entry->flag = TT_UPPER;
+            else if (best >= beta) entry->flag = TT_LOWER;
+            else entry->flag = TT_EXACT;
+        }
+        return best;
+    }
+
+    /// Win scores are stored relative to the node so they stay valid at any ply.
+    static int32_t toTable(int32_t value, uint8_t ply) {
+        if (value >= WIN_SCORE - MAX_PLY) return value + ply;
+        if (value <= -WIN_SCORE + MAX_PLY) return value - ply;
+        return value;
+    }
+
+    /// Inverse of toTable() at the probing node.
+    static int32_t fromTable(int32_t value, uint8_t ply) {
+        if (value >= WIN_SCORE - MAX_PLY) return value - ply;
+        if (value <= -WIN_SCORE + MAX_PLY) return value + ply;
+        return value;
+    }
+
+    /**
+     * @brief Credits a cutoff move; halves the side's scores once one passes HISTORY_LIMIT.
+     * @param side Side that played the move.
+     * @param move The move.
+     * @param depth Remaining depth of the cutoff.
+     */
+    void addHistory(Mark side, uint8_t move, uint8_t depth) {
+        uint32_t* scores = history[side - 1];
+        scores[move] += (uint32_t)depth * depth;
+        if (scores[move] < HISTORY_LIMIT) return;
+        for (uint8_t i = 0; i < CELLS; i++) scores[i] >>= 1;
+    }
+
+public:
+    /**
+     * @brief Collects empty cells near existing marks (all empty cells on an empty board).
+     * @param board The position.
+     * @param moves Output array of CELLS entries.
+     * @return Number of moves.
+     */
+    static uint8_t generateMoves(const BoardType& board, uint8_t* moves) {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < CELLS; i++) {
+            if (board.at(i) != MARK_NONE) continue;
+            if (board.markCount() == 0 || hasNeighbour(board, i)) moves[count++] = i;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Checks if a mark lies within NEIGHBOURHOOD of a cell.
+     * @param board The position.
+     * @param cell Cell index.
+     * @return True if a mark is close enough.
+     */
+    static bool hasNeighbour(const BoardType& board, uint8_t cell) {
+        int8_t r = cell / N;
+        int8_t c = cell % N;
+        for (int8_t dr = -NEIGHBOURHOOD; dr <= NEIGHBOURHOOD; dr++) {
+            for (int8_t dc = -NEIGHBOURHOOD; dc <= NEIGHBOURHOOD; dc++) {
+                int8_t rr = r + dr;
+                int8_t cc = c + dc;
+                if (rr < 0 || rr >= N || cc < 0 || cc >= N) continue;
+                if (board.at(rr * N + cc) != MARK_NONE) return true;
+            }
+        }
+        return false;
+    }
+
+protected:
+    /**
+     * @brief Sorts moves: killers first, then by history score, then by priority.
+     * @param board The position.
+     * @param ply Distance from the root.
+     * @param moves Moves to sort in place.
+     * @param count Number of moves.
+     */
+    void orderMoves(const BoardType& board, uint8_t ply, uint8_t* moves, uint8_t count) const {
+        uint32_t keys[CELLS];
+        Mark side = board.sideToMove();
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t m = moves[i];
+            uint32_t key = (history[side - 1][m] << 6) + board.priority(m);
+            if (m == killers[ply][0]) key |= 0x80000000UL;
+            else if (m == killers[ply][1]) key |= 0x40000000UL;
+            keys[i] = key;
+        }
+        for (uint8_t i = 1; i < count; i++) {
+            uint8_t m = moves[i];
+            uint32_t key = keys[i];
+            uint8_t j = i;
+            while (j > 0 && keys[j - 1] < key) {
+                moves[j] = moves[j - 1];
+                keys[j] = keys[j - 1];
+                j--;
+            }
+            moves[j] = m;
+            keys[j] = key;
+        }
+    }
+
+public:
+    /**
+     * @brief Immediate win, block of the opponent's win or fork, in that order.
+     * @param board The position.
+     * @return Cell index, or -1 if no tactical move applies.
+     */
+    static int16_t tacticalMove(BoardType& board) {
+        Mark me = board.sideToMove();
+        int16_t move = board.firstWinningCell(me);
+        if (move < 0) move = board.firstWinningCell(opponentOf(me));
+        if (move < 0) move = board.findForkMove(me);
+        return move;
+    }
+
+    /**
+     * @brief Picks the highest-priority empty cell, the first one in row-major order on ties.
+     * @param board The position.
+     * @return Cell index, or -1 if the board is full.
+     */
+    static int16_t priorityMove(const BoardType& board) {
+        int16_t best = -1;
+        uint8_t bestPriority = 0;
+        for (uint8_t i = 0; i < CELLS; i++) {
+            if (board.at(i) != MARK_NONE) continue;
+            uint8_t priority = board.priority(i);
+            if (best < 0 || priority > bestPriority) {
+                best = i;
+                bestPriority = priority;
+            }
+        }
+        return best;
+    }
+
+protected:
+    /**
+     * @brief Compares a root move with the best one so far.
+     * @return True if (value, priority, -cell) beats (best, its priority, -bestMove).
+     */
+    bool isBetter(const BoardType& board, int32_t value, uint8_t move, int32_t best, uint8_t bestMove) const {
+        if (value != best) return value > best;
+        uint8_t p = board.priority(move);
+        uint8_t q = board.priority(bestMove);
+        if (p != q) return p > q;
+        return move < bestMove;
+    }
+
+    /**
+     * @brief Moves a root move to the front so the next iteration searches it first.
+     */
+    static void moveToFront(uint8_t* moves, uint8_t count, uint8_t move) {
+        for (uint8_t i = 0; i < count; i++) {
+            if (moves[i] != move) continue;
+            for (; i > 0; i--) moves[i] = moves[i - 1];
+            moves[0] = move;
+            return;
+        }
+    }
+
+    uint8_t killers[MAX_PLY][2];  ///< Two most recent cutoff moves per ply.
+    uint32_t history[2][CELLS];   ///< Cutoff history per side and cell.
+    uint32_t nodes;               ///< Nodes searched in the current call.
+    uint32_t nodeLimit;           ///< Node budget of the current call (0 = none).
+    uint32_t timeLimit;           ///< Time budget of the current call in microseconds (0 = none).
+    uint32_t started;             ///< searchMicros() at the start of the current call.
+    bool aborted;                 ///< Set when the budget ran out mid-iteration.
+};
+
+#endif // BOARD_SEARCH_H
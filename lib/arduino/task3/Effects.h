@@ -0,0 +1,113 @@
+/**
+ * @file Effects.h
+ * @brief Cooperative, millis()-driven scheduler of timed LED pin writes.
+ *
+ * Blinks used to be digitalWrite(HIGH), delay(300), digitalWrite(LOW), which
+ * stopped serial reads for 300 ms per blink. Now an effect writes what is due
+ * at once and queues the rest as (time, pin, level) actions; loop() calls
+ * service() every pass, so blinks run while commands are handled. The queue
+ * is a fixed array: nothing is allocated and a full queue drops the effect
+ * instead of blocking.
+ */
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @struct PinAction
+ * @brief One queued pin write.
+ */
+struct PinAction {
+    unsigned long at; ///< millis() at which the write is due.
+    uint8_t pin;      ///< Digital pin.
+    uint8_t level;    ///< HIGH or LOW.
+};
+
+/**
+ * @class EffectScheduler
+ * @brief Fixed-size queue of timed pin writes.
+ * @tparam Capacity Maximum number of queued actions.
+ */
+template <uint8_t Capacity>
+class EffectScheduler {
+public:
+    EffectScheduler() : count(0) {}
+
+    /**
+     * @brief Queues a pin write.
+     * @param pin Digital pin.
+     * @param level HIGH or LOW.
+     * @param delayMs Time from now until the write.
+     * @param now Current millis().
+     * @return False if the queue is full.
+     */
+    bool schedule(uint8_t pin, uint8_t level, unsigned long delayMs, unsigned long now) {
+        if (count == Capacity) return false;
+        PinAction& action = actions[count++];
+        action.at = now + delayMs;
+        action.pin = pin;
+        action.level = level;
+        return true;
+    }
+
+    /**
+     * @brief Drives a pin HIGH now and LOW after durationMs.
+     * A pulse already running on the pin is restarted, not stacked.
+     * @return False if the queue is full (the pin is left untouched).
+     */
+    bool pulse(uint8_t pin, unsigned long durationMs, unsigned long now) {
+        cancel(pin);
+        if (!schedule(pin, LOW, durationMs, now)) return false;
+        digitalWrite(pin, HIGH);
+        return true;
+    }
+
+    /// Drops the queued writes of a pin.
+    void cancel(uint8_t pin) {
+        for (uint8_t i = 0; i < count;) {
+            if (actions[i].pin == pin) {
+                remove(i);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    /**
+     * @brief Performs the writes that are due; call from every loop().
+     * Due writes happen in the order they were queued. Times are compared
+     * as differences, so millis() overflow is harmless.
+     * @param now Current millis().
+     * @return Number of writes performed.
+     */
+    uint8_t service(unsigned long now) {
+        uint8_t done = 0;
+        for (uint8_t i = 0; i < count;) {
+            if ((long)(now - actions[i].at) >= 0) {
+                digitalWrite(actions[i].pin, actions[i].level);
+                remove(i);
+                done++;
+            } else {
+                i++;
+            }
+        }
+        return done;
+    }
+
+    /// @return Number of queued writes.
+    uint8_t pending() const { return count; }
+
+private:
+    /// Removes an action, keeping the others in queue order.
+    void remove(uint8_t index) {
+        count--;
+        for (uint8_t i = index; i < count; i++) actions[i] = actions[i + 1];
+    }
+
+    PinAction actions[Capacity];
+    uint8_t count;
+};
+
+#endif // EFFECTS_H
@@ -0,0 +1,153 @@
+/**
+ * @file Ingest.h
+ * @brief Serial ingest stage and hashed command lookup of the firmware.
+ *
+ * loop() drains everything Serial.available() reports into a ByteRing and
+ * then handles every complete command found there, so a burst such as
+ * "player\n1,1\n" is answered in one pass instead of one byte per loop().
+ * When the ring is full the rest stays in the UART buffer; nothing is
+ * dropped by the ingest stage itself.
+ *
+ * Text commands are routed through CommandTable: a small open-addressed hash
+ * of the command names, built on first use, so a command costs one hash and
+ * normally one strcmp_P. The names and the command list stay in flash; only
+ * the slot indices take SRAM.
+ */
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#endif
+#ifndef strlen_P
+#define strlen_P(flashText) strlen(flashText)
+#endif
+#ifndef strcmp_P
+#define strcmp_P(text, flashText) strcmp((text), (flashText))
+#endif
+#ifndef memcpy_P
+#define memcpy_P(destination, source, size) memcpy((destination), (source), (size))
+#endif
+#endif
+
+/**
+ * @class ByteRing
+ * @brief Fixed-size byte FIFO.
+ * @tparam Capacity Size in bytes, a power of two up to 128.
+ */
+template <uint8_t Capacity>
+class ByteRing {
+public:
+    ByteRing() : head(0), tail(0) {}
+
+    /// @return False if the ring is full.
+    bool push(uint8_t byte) {
+        if (full()) return false;
+        data[head++ & (Capacity - 1)] = byte;
+        return true;
+    }
+
+    /// @return False if the ring is empty.
+    bool pop(uint8_t& byte) {
+        if (empty()) return false;
+        byte = data[tail++ & (Capacity - 1)];
+        return true;
+    }
+
+    uint8_t size() const { return head - tail; }
+    bool empty() const { return head == tail; }
+    bool full() const { return size() == Capacity; }
+    void clear() { head = tail = 0; }
+
+private:
+    uint8_t data[Capacity];
+    uint8_t head; ///< Free-running write index.
+    uint8_t tail; ///< Free-running read index.
+};
+
+/// Handler of a text command.
+typedef void (*CommandHandler)();
+
+/**
+ * @struct CommandEntry
+ * @brief One text command and its handler; lists of them live in PROGMEM.
+ */
+struct CommandEntry {
+    const char* name;       ///< Command name, a PROGMEM string.
+    CommandHandler handler;
+};
+
+/**
+ * @class CommandTable
+ * @brief Hashed lookup of a fixed list of commands.
+ * @tparam Slots Hash slots, a power of two larger than the number of commands.
+ */
+template <uint8_t Slots>
+class CommandTable {
+public:
+    /**
+     * @param entries Commands in PROGMEM; must outlive the table.
+     * @param count Number of commands (less than Slots).
+     */
+    CommandTable(const CommandEntry* entries, uint8_t count) : entries(entries), count(count), built(false) {}
+
+    /**
+     * @brief Finds a command by name.
+     * @param name Received text, in RAM.
+     * @return The handler, or 0 if the name is unknown.
+     */
+    CommandHandler find(const char* name) {
+        if (!built) build();
+        uint8_t length = (uint8_t)strlen(name);
+        uint8_t slot = length == 0 ? 0 : hash(name[0], name[length - 1], length);
+        for (uint8_t probe = 0; probe < Slots; slot = (slot + 1) & (Slots - 1), probe++) {
+            if (slots[slot] == EMPTY) return 0;
+            CommandEntry entry = load(slots[slot]);
+            if (strcmp_P(name, entry.name) == 0) return entry.handler;
+        }
+        return 0;
+    }
+
+private:
+    static const uint8_t EMPTY = 0xFF;
+
+    /// First byte, last byte and length; distinct for every current command.
+    static uint8_t hash(uint8_t first, uint8_t last, uint8_t length) {
+        return (uint8_t)(first * 3 + last + length * 7) & (Slots - 1);
+    }
+
+    /// @return Entry i, copied out of flash.
+    CommandEntry load(uint8_t i) const {
+        CommandEntry entry;
+        memcpy_P(&entry, &entries[i], sizeof(entry));
+        return entry;
+    }
+
+    void build() {
+        memset(slots, EMPTY, sizeof(slots));
+        for (uint8_t i = 0; i < count; i++) {
+            const char* name = load(i).name;
+            uint8_t length = (uint8_t)strlen_P(name);
+            uint8_t slot = hash(pgm_read_byte(name), pgm_read_byte(name + length - 1), length);
+            while (slots[slot] != EMPTY) slot = (slot + 1) & (Slots - 1);
+            slots[slot] = i;
+        }
+        built = true;
+    }
+
+    const CommandEntry* entries;
+    uint8_t count;
+    bool built;
+    uint8_t slots[Slots]; ///< Index into entries, EMPTY if unused.
+};
+
+#endif // INGEST_H
@@ -0,0 +1,148 @@
+/**
+ * @file Link.h
+ * @brief Serial link speed: the rates the board offers, trials and fallback.
+ *
+ * The board always starts at LINK_DEFAULT_BAUD. A client asks for the rate
+ * list ("baud"), requests one ("baud <rate>"), and both sides switch after
+ * the reply. The new rate is on trial: the client echoes LINK_PATTERN a few
+ * times ("sync <pattern>") and confirms with "baud ok". A trial that is not
+ * confirmed within LINK_TRIAL_MS, or LINK_ERROR_LIMIT link errors within
+ * LINK_ERROR_WINDOW_MS at a raised rate, drops the board back to the
+ * default rate, where the client finds it again. The class only keeps the
+ * state; task3.ino switches the UART. The rate list and the pattern live in
+ * flash on AVR.
+ */
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(address) (*(const uint32_t*)(address))
+#endif
+#ifndef strcmp_P
+#define strcmp_P(text, flashText) strcmp((text), (flashText))
+#endif
+#endif
+
+/// Rate the board starts at and falls back to.
+const uint32_t LINK_DEFAULT_BAUD = 9600;
+
+/// Rates offered, ascending. 250k, 500k and 1M are exact on a 16 MHz Uno.
+const uint32_t LINK_RATES[] PROGMEM = { 9600, 19200, 38400, 57600, 115200, 250000, 500000, 1000000 };
+
+/// Number of entries in LINK_RATES.
+const uint8_t LINK_RATE_COUNT = sizeof(LINK_RATES) / sizeof(LINK_RATES[0]);
+
+/// Test pattern of "sync": alternating bits, runs and the top of the printable range.
+const char LINK_PATTERN[] PROGMEM = "UU**33ff~~@@pp";
+
+/// @return Entry i of LINK_RATES.
+inline uint32_t linkRate(uint8_t i) {
+    return pgm_read_dword(&LINK_RATES[i]);
+}
+
+/// Time a new rate has to be confirmed in.
+const unsigned long LINK_TRIAL_MS = 1000;
+
+/// Link errors at a raised rate that make the board fall back.
+const uint8_t LINK_ERROR_LIMIT = 3;
+
+/// Window LINK_ERROR_LIMIT errors have to fall into.
+const unsigned long LINK_ERROR_WINDOW_MS = 2000;
+
+/**
+ * @class LinkSpeed
+ * @brief Current rate, the trial of a new one and the fallback to the default.
+ */
+class LinkSpeed {
+public:
+    LinkSpeed() : fallbacks(0), rate(LINK_DEFAULT_BAUD), trial(false), trialStart(0), windowStart(0),
+                  windowErrors(0), lastErrors(0) {}
+
+    /// @return True if rate is in LINK_RATES.
+    static bool supported(uint32_t rate) {
+        for (uint8_t i = 0; i < LINK_RATE_COUNT; i++) {
+            if (linkRate(i) == rate) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Switches to a rate; any rate but the default is on trial until confirm().
+     * @param newRate Requested rate.
+     * @param now Current millis().
+     * @return False if the rate is not supported; nothing changes then.
+     */
+    bool startTrial(uint32_t newRate, unsigned long now) {
+        if (!supported(newRate)) return false;
+        rate = newRate;
+        trial = newRate != LINK_DEFAULT_BAUD;
+        trialStart = now;
+        windowStart = now;
+        windowErrors = 0;
+        return true;
+    }
+
+    /**
+     * @brief Keeps the rate on trial.
+     * @return False if no trial was running.
+     */
+    bool confirm() {
+        if (!trial) return false;
+        trial = false;
+        return true;
+    }
+
+    /**
+     * @brief Ends an expired trial and watches the error count (loop()).
+     * @param now Current millis().
+     * @param errors Link errors counted since boot.
+     * @return The rate to switch the UART to, or 0 to keep it.
+     */
+    uint32_t service(unsigned long now, uint16_t errors) {
+        uint16_t fresh = errors - lastErrors;
+        lastErrors = errors;
+        if (rate == LINK_DEFAULT_BAUD) return 0;
+        if (trial && now - trialStart >= LINK_TRIAL_MS) return fallBack();
+        if (fresh == 0) return 0;
+        if (now - windowStart > LINK_ERROR_WINDOW_MS) {
+            windowStart = now;
+            windowErrors = 0;
+        }
+        windowErrors = windowErrors + fresh > 255 ? 255 : windowErrors + fresh;
+        return windowErrors >= LINK_ERROR_LIMIT ? fallBack() : 0;
+    }
+
+    /// @return Current rate.
+    uint32_t baud() const { return rate; }
+
+    /// @return True while the current rate waits for confirm().
+    bool inTrial() const { return trial; }
+
+    uint16_t fallbacks; ///< Returns to the default rate since boot.
+
+private:
+    uint32_t fallBack() {
+        rate = LINK_DEFAULT_BAUD;
+        trial = false;
+        fallbacks++;
+        return rate;
+    }
+
+    uint32_t rate;              ///< Current rate.
+    bool trial;                 ///< rate is not confirmed yet.
+    unsigned long trialStart;   ///< millis() of the switch to rate.
+    unsigned long windowStart;  ///< millis() the error window opened.
+    uint8_t windowErrors;       ///< Errors in the current window.
+    uint16_t lastErrors;        ///< Error count seen by the last service().
+};
+
+#endif // LINK_H
@@ -0,0 +1,252 @@
+/**
+ * @file Mcts.h
+ * @brief Monte Carlo tree search for Board<N, K> in a fixed node pool.
+ *
+ * The anytime engine beside BoardSearch. Every iteration walks down the tree
+ * by UCB1, expands the leaf it reaches, plays the game out with random moves
+ * and adds the result to the nodes on the path; the node or time budget of
+ * SearchLimits can stop it after any iteration, and the most visited root
+ * move is the answer. The tree lives in POOL nodes inside the object, so the
+ * search takes nothing from the heap; once the pool is full it keeps playing
+ * out from the leaves it has. UCB1 is computed in fixed point and the random
+ * moves come from a generator seeded by the position, so a search that is
+ * stopped by its playout budget gives the same move on the board and on the
+ * host; one cut short by its time budget may not. An immediate win or block
+ * is played without searching.
+ */
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdint.h>
+#include "Board.h"
+#include "BoardSearch.h"
+
+/**
+ * @struct MctsNode
+ * @brief One tree node, 8 bytes; the children of a node are allocated together.
+ */
+struct MctsNode {
+    uint16_t firstChild; ///< Pool index of the first child.
+    uint16_t visits;     ///< Playouts through this node.
+    uint16_t score;      ///< Half points of those playouts for the side that moved here.
+    uint8_t childCount;  ///< Children allocated, 0 for a leaf.
+    uint8_t move;        ///< Cell played to reach this node.
+};
+
+/**
+ * @class MctsSearch
+ * @brief Node pool and generator of one board type.
+ * @tparam N Board side.
+ * @tparam K Marks in a row needed to win.
+ * @tparam POOL Nodes in the pool (at least 1 + CELLS to search at all).
+ */
+template <uint8_t N, uint8_t K, uint16_t POOL>
+class MctsSearch {
+public:
+    typedef Board<N, K> BoardType;
+
+    enum {
+        CELLS = BoardType::CELLS,
+        MAX_PLY = BoardType::CELLS + 1,
+        MAX_PLAYOUTS = 32767 ///< Playouts per call; keeps score in 16 bits.
+    };
+
+    MctsSearch() : used(0), state(1) {}
+
+    /**
+     * @brief Finds the best move for the side to move.
+     * @param board The position; restored before returning.
+     * @param limits maxNodes playouts and maxMicros; with neither, POOL
+     *               playouts. maxDepth is not used.
+     * @return The chosen move; value is the move's points per mille, depth
+     *         the deepest tree node and nodes the playouts.
+     */
+    SearchResult findBestMove(BoardType& board, SearchLimits limits) {
+        SearchResult result = {-1, 0, 0, 0};
+        if (board.isFull()) return result;
+        Mark side = board.sideToMove();
+        result.move = board.firstWinningCell(side);
+        if (result.move < 0) result.move = board.firstWinningCell(opponentOf(side));
+        if (result.move >= 0) return result;
+        result.move = BoardSearch<N, K>::priorityMove(board);
+
+        uint32_t budget = limits.maxNodes != 0 ? limits.maxNodes : limits.maxMicros != 0 ? (uint32_t)MAX_PLAYOUTS : (uint32_t)POOL;
+        if (budget > MAX_PLAYOUTS) budget = MAX_PLAYOUTS;
+        uint32_t started = searchMicros();
+        seed(board);
+        used = 1;
+        pool[0].firstChild = 0;
+        pool[0].childCount = 0;
+        pool[0].visits = 0;
+        pool[0].score = 0;
+        pool[0].move = 0;
+        uint8_t depth = 0;
+        while (result.nodes < budget) {
+            if (limits.maxMicros != 0 && searchMicros() - started >= limits.maxMicros) break;
+            uint8_t reached = iterate(board, side);
+            if (reached > depth) depth = reached;
+            result.nodes++;
+        }
+
+        const MctsNode& root = pool[0];
+        int16_t best = -1;
+        for (uint8_t i = 0; i < root.childCount; i++) {
+            const MctsNode& child = pool[root.firstChild + i];
+            if (child.visits == 0) continue;
+            if (best < 0 || child.visits > pool[best].visits ||
+                (child.visits == pool[best].visits && board.priority(child.move) > board.priority(pool[best].move))) {
+                best = root.firstChild + i;
+            }
+        }
+        if (best >= 0) {
+            result.move = pool[best].move;
+            result.value = (int32_t)pool[best].score * 500 / pool[best].visits;
+            result.depth = depth;
+        }
+        return result;
+    }
+
+    /// @return Pool nodes used by the last search.
+    uint16_t nodesUsed() const { return used; }
+
+private:
+    /**
+     * @brief One selection, expansion, playout and update.
+     * @param board The root position; restored before returning.
+     * @param rootSide Side to move at the root.
+     * @return Depth of the tree node the playout started from.
+     */
+    uint8_t iterate(BoardType& board, Mark rootSide) {
+        uint16_t path[MAX_PLY];
+        uint8_t depth = 0;
+        uint16_t node = 0;
+        path[0] = 0;
+        while (pool[node].childCount != 0 && board.winner() == MARK_NONE) {
+            node = selectChild(node);
+            board.place(pool[node].move);
+            path[++depth] = node;
+        }
+        if (board.winner() == MARK_NONE && !board.isFull() && (node == 0 || pool[node].visits > 0) && expand(board, node)) {
+            node = pool[node].firstChild;
+            board.place(pool[node].move);
+            path[++depth] = node;
+        }
+
+        Mark winner = playout(board);
+        for (int16_t d = depth; d >= 0; d--) {
+            MctsNode& n = pool[path[d]];
+            Mark mover = (d % 2 == 1) ? rootSide : opponentOf(rootSide);
+            n.visits++;
+            n.score += winner == MARK_NONE ? 1 : winner == mover ? 2 : 0;
+        }
+        for (uint8_t d = depth; d >= 1; d--) board.undo(pool[path[d]].move);
+        return depth;
+    }
+
+    /**
+     * @brief Picks the child with the highest UCB1, an unvisited one first.
+     * Fixed point, 256 = 1: mean points plus sqrt(2 ln(parent) / visits).
+     */
+    uint16_t selectChild(uint16_t node) const {
+        const MctsNode& parent = pool[node];
+        uint32_t logVisits = (uint32_t)bitLength(parent.visits) * 177; // ln 2 = 177 / 256
+        uint16_t best = parent.firstChild;
+        uint32_t bestValue = 0;
+        for (uint8_t i = 0; i < parent.childCount; i++) {
+            uint16_t index = parent.firstChild + i;
+            const MctsNode& child = pool[index];
+            if (child.visits == 0) return index;
+            uint32_t value = (uint32_t)child.score * 128 / child.visits + squareRoot(logVisits * 512 / child.visits);
+            if (value > bestValue) {
+                best = index;
+                bestValue = value;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Allocates the children of a leaf, one per candidate move.
+     * @return False if the pool has no room for them.
+     */
+    bool expand(const BoardType& board, uint16_t node) {
+        uint8_t moves[CELLS];
+        uint8_t count = BoardSearch<N, K>::generateMoves(board, moves);
+        if (count == 0 || used + count > POOL) return false;
+        pool[node].firstChild = used;
+        pool[node].childCount = count;
+        for (uint8_t i = 0; i < count; i++) {
+            MctsNode& child = pool[used++];
+            child.firstChild = 0;
+            child.childCount = 0;
+            child.visits = 0;
+            child.score = 0;
+            child.move = moves[i];
+        }
+        return true;
+    }
+
+    /**
+     * @brief Plays random moves until the game ends, then takes them back.
+     * @return The winner, MARK_NONE for a draw.
+     */
+    Mark playout(BoardType& board) {
+        uint8_t played[CELLS];
+        uint8_t count = 0;
+        while (board.winner() == MARK_NONE && !board.isFull()) {
+            // Scales 16 random bits to the empty cells: a multiply, not a 32-bit division.
+            uint8_t skip = (uint8_t)(((nextRandom() >> 16) * (uint32_t)(CELLS - board.markCount())) >> 16);
+            uint8_t cell = 0;
+            for (;; cell++) {
+                if (board.at(cell) == MARK_NONE && skip-- == 0) break;
+            }
+            board.place(cell);
+            played[count++] = cell;
+        }
+        Mark winner = board.winner();
+        while (count > 0) board.undo(played[--count]);
+        return winner;
+    }
+
+    /// Seeds the generator from the position, so equal searches play equal games.
+    void seed(const BoardType& board) {
+        state = 2463534242UL;
+        for (uint8_t i = 0; i < CELLS; i++) state = state * 31 + board.at(i) + 1;
+        if (state == 0) state = 1;
+    }
+
+    /// xorshift32.
+    uint32_t nextRandom() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    /// @return Number of significant bits of value (floor(log2) + 1, 0 for 0).
+    static uint8_t bitLength(uint16_t value) {
+        uint8_t bits = 0;
+        for (; value != 0; value >>= 1) bits++;
+        return bits;
+    }
+
+    /// @return floor(sqrt(value)), bit by bit.
+    static uint32_t squareRoot(uint32_t value) {
+        uint32_t root = 0;
+        for (uint32_t bit = 1UL << 30; bit != 0; bit >>= 2) {
+            if (value >= root + bit) {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+        }
+        return root;
+    }
+
+    MctsNode pool[POOL];  ///< The tree; pool[0] is the root.
+    uint16_t used;        ///< Nodes allocated in the current search.
+    uint32_t state;       ///< Generator state.
+};
+
+#endif // MCTS_H
@@ -0,0 +1,203 @@
+/**
+ * @file MoveTable.h
+ * @brief AI reply for every position indexed by positionIndex().
+ *
+ * Generated by lib/host/gen_move_table.cpp (make movetable), do not edit.
+ * Entry i is stored in the low nibble of byte i / 2 when i is even and in
+ * the high nibble otherwise; NO_TABLE_MOVE marks positions without a move.
+ */
+#ifndef MOVE_TABLE_H
+#define MOVE_TABLE_H
+
+#include "PositionIndex.h"
+
+/// Packed best moves, two cells per byte.
+const uint8_t MOVE_TABLE[2960] PROGMEM = {
+    0x44, 0x44, 0x04, 0x44, 0x44, 0x44, 0x24, 0x44, 0x44, 0x44, 0x04, 0x44, 0x44, 0x44, 0x04, 0x44,
+    0x44, 0x44, 0x04, 0x44, 0x44, 0x02, 0x00, 0x00, 0x00, 0x44, 0x44, 0x40, 0x44, 0x44, 0x44, 0x40,
+    0x44, 0x44, 0x44, 0x40, 0x44, 0x44, 0x44, 0x40, 0x44, 0x44, 0x74, 0x56, 0x84, 0x34, 0x44, 0x24,
+    0x44, 0x44, 0x41, 0x48, 0x45, 0x22, 0x67, 0x64, 0x84, 0x56, 0x84, 0x34, 0x43, 0x20, 0x44, 0x44,
+    0x40, 0x48, 0x45, 0x20, 0x67, 0x64, 0x84, 0x57, 0x44, 0x34, 0x43, 0x00, 0x44, 0x44, 0x41, 0x48,
+    0x44, 0x40, 0x67, 0x12, 0x80, 0x67, 0x44, 0x08, 0x44, 0x24, 0x44, 0x44, 0x41, 0x48, 0x54, 0x20,
+    0x67, 0x12, 0x60, 0x00, 0x02, 0x08, 0x03, 0x00, 0x20, 0x00, 0x00, 0x28, 0x50, 0x20, 0x67, 0x12,
+    0x60, 0x44, 0x78, 0x06, 0x43, 0x04, 0x42, 0x44, 0x14, 0x48, 0x44, 0x04, 0x67, 0x12, 0x40, 0x44,
+    0x78, 0x50, 0x44, 0x48, 0x43, 0x44, 0x14, 0x44, 0x54, 0x04, 0x42, 0x12, 0x60, 0x44, 0x08, 0x56,
+    0x44, 0x48, 0x33, 0x44, 0x20, 0x44, 0x54, 0x04, 0x42, 0x12, 0x60, 0x44, 0x72, 0x56, 0x44, 0x44,
+    0x33, 0x44, 0x20, 0x44, 0x44, 0x14, 0x44, 0x64, 0x82, 0x22, 0x24, 0x22, 0x24, 0x22, 0x52, 0x22,
+    0x22, 0x42, 0x17, 0x14, 0x81, 0x11, 0x41, 0x11, 0x11, 0x16, 0x11, 0x11, 0x86, 0x40, 0x00, 0x03,
+    0x00, 0x04, 0x00, 0x40, 0x00, 0x00, 0x60, 0x66, 0x66, 0x46, 0x24, 0x64, 0x66, 0x86, 0x66, 0x66,
+    0x67, 0x84, 0x46, 0x08, 0x44, 0x42, 0x44, 0x00, 0x48, 0x05, 0x72, 0x46, 0x78, 0x64, 0x50, 0x05,
+    0x44, 0x14, 0x80, 0x44, 0x00, 0x67, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x38, 0x15, 0x72,
+    0x76, 0x77, 0x77, 0x77, 0x77, 0x27, 0x00, 0x80, 0x77, 0x77, 0x67, 0x66, 0x66, 0x66, 0x53, 0x00,
+    0x66, 0x66, 0x68, 0x66, 0x76, 0x56, 0x55, 0x02, 0x58, 0x55, 0x50, 0x55, 0x50, 0x55, 0x25, 0x55,
+    0x83, 0x74, 0x26, 0x44, 0x22, 0x34, 0x12, 0x38, 0x43, 0x72, 0x46, 0x46, 0x68, 0x32, 0x04, 0x42,
+    0x24, 0x82, 0x44, 0x04, 0x67, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x48, 0x44, 0x70, 0x46,
+    0x44, 0x78, 0x46, 0x44, 0x42, 0x44, 0x41, 0x44, 0x04, 0x44, 0x33, 0x63, 0x02, 0x33, 0x03, 0x33,
+    0x23, 0x33, 0x33, 0x30, 0x33, 0x84, 0x33, 0x35, 0x43, 0x33, 0x23, 0x33, 0x33, 0x32, 0x33, 0x47,
+    0x87, 0x50, 0x84, 0x34, 0x44, 0x02, 0x40, 0x25, 0x20, 0x40, 0x44, 0x78, 0x45, 0x44, 0x43, 0x44,
+    0x41, 0x44, 0x04, 0x44, 0x12, 0x80, 0x00, 0x04, 0x00, 0x04, 0x00, 0x40, 0x00, 0x00, 0x20, 0x01,
+    0x22, 0x27, 0x82, 0x22, 0x02, 0x22, 0x22, 0x25, 0x22, 0x12, 0x20, 0x42, 0x78, 0x80, 0x42, 0x23,
+    0x41, 0x33, 0x04, 0x63, 0x48, 0x66, 0x65, 0x48, 0x43, 0x14, 0x12, 0x54, 0x21, 0x12, 0x44, 0x84,
+    0x56, 0x44, 0x34, 0x44, 0x24, 0x44, 0x44, 0x40, 0x64, 0x66, 0x88, 0x45, 0x46, 0x33, 0x04, 0x10,
+    0x44, 0x01, 0x11, 0x12, 0x80, 0x66, 0x64, 0x68, 0x44, 0x24, 0x44, 0x54, 0x20, 0x24, 0x01, 0x61,
+    0x11, 0x16, 0x11, 0x10, 0x11, 0x01, 0x11, 0x11, 0x12, 0x60, 0x48, 0x88, 0x86, 0x43, 0x04, 0x42,
+    0x44, 0x04, 0x84, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x44, 0x45, 0x20, 0x44, 0x74, 0x56,
+    0x44, 0x34, 0x44, 0x24, 0x44, 0x44, 0x41, 0x74, 0x46, 0x62, 0x75, 0x44, 0x33, 0x04, 0x02, 0x44,
+    0x20, 0x00, 0x55, 0x55, 0x55, 0x46, 0x34, 0x55, 0x55, 0x50, 0x55, 0x05, 0x25, 0x01, 0x72, 0x46,
+    0x00, 0x56, 0x44, 0x42, 0x45, 0x10, 0x40, 0x12, 0x60, 0x00, 0x06, 0x00, 0x03, 0x00, 0x20, 0x00,
+    0x00, 0x20, 0x01, 0x22, 0x24, 0x62, 0x22, 0x42, 0x22, 0x22, 0x24, 0x22, 0x77, 0x77, 0x77, 0x77,
+    0x77, 0x77, 0x77, 0x27, 0x04, 0x12, 0x60, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x43, 0x04,
+    0x42, 0x45, 0x23, 0x34, 0x42, 0x22, 0x64, 0x82, 0x22, 0x24, 0x22, 0x55, 0x32, 0x22, 0x24, 0x22,
+    0x25, 0x22, 0x52, 0x34, 0x81, 0x17, 0x14, 0x41, 0x13, 0x14, 0x41, 0x11, 0x41, 0x17, 0x16, 0x71,
+    0x11, 0x41, 0x11, 0x11, 0x45, 0x03, 0x34, 0x30, 0x00, 0x86, 0x40, 0x00, 0x03, 0x00, 0x34, 0x40,
+    0x00, 0x03, 0x00, 0x04, 0x00, 0x60, 0x66, 0x46, 0x12, 0x44, 0x62, 0x66, 0x66, 0x46, 0x14, 0x68,
+    0x66, 0x66, 0x76, 0x24, 0x62, 0x66, 0x16, 0x86, 0x68, 0x24, 0x40, 0x24, 0x84, 0x46, 0x08, 0x48,
+    0x82, 0x24, 0x20, 0x00, 0x44, 0x20, 0x54, 0x20, 0x70, 0x84, 0x57, 0x78, 0x44, 0x40, 0x01, 0x44,
+    0x81, 0x14, 0x48, 0x01, 0x64, 0x40, 0x07, 0x47, 0x04, 0x06, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x88, 0x88, 0x25, 0x25, 0x21, 0x57, 0x27, 0x56, 0x26, 0x71, 0x77, 0x77, 0x72, 0x77,
+    0x67, 0x06, 0x82, 0x30, 0x08, 0x78, 0x77, 0x77, 0x77, 0x77, 0x67, 0x65, 0x02, 0x66, 0x66, 0x13,
+    0x30, 0x00, 0x66, 0x66, 0x66, 0x83, 0x80, 0x66, 0x66, 0x66, 0x73, 0x70, 0x66, 0x66, 0x50, 0x12,
+    0x50, 0x55, 0x02, 0x58, 0x55, 0x02, 0x58, 0x55, 0x58, 0x55, 0x22, 0x50, 0x55, 0x52, 0x55, 0x52,
+    0x64, 0x67, 0x84, 0x24, 0x21, 0x44, 0x24, 0x11, 0x44, 0x18, 0x43, 0x74, 0x26, 0x47, 0x27, 0x64,
+    0x16, 0x61, 0x66, 0x36, 0x02, 0x02, 0x40, 0x46, 0x68, 0x32, 0x04, 0x42, 0x44, 0x02, 0x30, 0x04,
+    0x40, 0x66, 0x00, 0x88, 0x88, 0x18, 0x88, 0x88, 0x88, 0x88, 0x80, 0x88, 0x88, 0x44, 0x14, 0x00,
+    0x73, 0x00, 0x44, 0x06, 0x40, 0x12, 0x40, 0x44, 0x22, 0x40, 0x44, 0x01, 0x41, 0x44, 0x41, 0x44,
+    0x01, 0x40, 0x44, 0x40, 0x44, 0x40, 0x23, 0x01, 0x33, 0x13, 0x00, 0x33, 0x63, 0x02, 0x33, 0x03,
+    0x33, 0x63, 0x00, 0x33, 0x03, 0x33, 0x63, 0x83, 0x53, 0x35, 0x44, 0x33, 0x31, 0x44, 0x33, 0x31,
+    0x43, 0x33, 0x54, 0x33, 0x35, 0x23, 0x33, 0x23, 0x33, 0x87, 0x55, 0x48, 0x34, 0x03, 0x44, 0x84,
+    0x50, 0x84, 0x34, 0x44, 0x25, 0x00, 0x02, 0x02, 0x54, 0x02, 0x42, 0x57, 0x45, 0x44, 0x33, 0x40,
+    0x44, 0x01, 0x41, 0x44, 0x41, 0x44, 0x01, 0x40, 0x44, 0x40, 0x44, 0x40, 0x24, 0x01, 0x12, 0x80,
+    0x00, 0x12, 0x10, 0x00, 0x04, 0x00, 0x12, 0x10, 0x00, 0x02, 0x00, 0x04, 0x00, 0x30, 0x12, 0x20,
+    0x01, 0x22, 0x28, 0x01, 0x22, 0x20, 0x82, 0x22, 0x01, 0x22, 0x25, 0x02, 0x22, 0x52, 0x22, 0x23,
+    0x01, 0x12, 0x80, 0x07, 0x12, 0x20, 0x44, 0x01, 0x11, 0x12, 0x40, 0x44, 0x01, 0x00, 0x44, 0x43,
+    0x80, 0x56, 0x85, 0x44, 0x33, 0x41, 0x44, 0x12, 0x42, 0x44, 0x52, 0x54, 0x52, 0x25, 0x21, 0x42,
+    0x14, 0x22, 0x64, 0x55, 0x44, 0x34, 0x03, 0x24, 0x24, 0x00, 0x44, 0x24, 0x44, 0x24, 0x00, 0x44,
+    0x04, 0x44, 0x04, 0x64, 0x58, 0x65, 0x44, 0x33, 0x30, 0x01, 0x03, 0x30, 0x04, 0x43, 0x44, 0x01,
+    0x40, 0x44, 0x30, 0x04, 0x10, 0x24, 0x01, 0x12, 0x80, 0x66, 0x12, 0x20, 0x02, 0x44, 0x24, 0x12,
+    0x10, 0x00, 0x22, 0x00, 0x44, 0x04, 0x32, 0x12, 0x20, 0x01, 0x61, 0x21, 0x01, 0x01, 0x11, 0x10,
+    0x21, 0x01, 0x01, 0x11, 0x12, 0x11, 0x10, 0x11, 0x23, 0x01, 0x12, 0x60, 0x68, 0x12, 0x10, 0x00,
+    0x22, 0x00, 0x12, 0x40, 0x44, 0x01, 0x00, 0x43, 0x04, 0x30, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x88, 0x20, 0x01, 0x44, 0x15, 0x00, 0x20, 0x02, 0x02, 0x64, 0x55, 0x44, 0x34, 0x13,
+    0x44, 0x24, 0x21, 0x44, 0x24, 0x44, 0x24, 0x11, 0x44, 0x14, 0x44, 0x14, 0x64, 0x56, 0x75, 0x44,
+    0x33, 0x30, 0x02, 0x02, 0x30, 0x04, 0x42, 0x46, 0x62, 0x45, 0x44, 0x33, 0x04, 0x02, 0x55, 0x55,
+    0x46, 0x34, 0x03, 0x15, 0x55, 0x55, 0x43, 0x30, 0x55, 0x55, 0x50, 0x44, 0x14, 0x55, 0x55, 0x40,
+    0x12, 0x20, 0x01, 0x72, 0x26, 0x01, 0x22, 0x40, 0x44, 0x22, 0x01, 0x01, 0x41, 0x04, 0x51, 0x44,
+    0x41, 0x23, 0x01, 0x12, 0x60, 0x00, 0x12, 0x10, 0x00, 0x03, 0x00, 0x12, 0x60, 0x00, 0x02, 0x00,
+    0x03, 0x00, 0x30, 0x12, 0x20, 0x01, 0x22, 0x26, 0x01, 0x21, 0x20, 0x02, 0x22, 0x01, 0x22, 0x24,
+    0x10, 0x22, 0x42, 0x22, 0x73, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x07, 0x12, 0x20,
+    0x44, 0x01, 0x11, 0x44, 0x40, 0x31, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x20,
+    0x01, 0x01, 0x20, 0x02, 0x30, 0x44, 0x20, 0x56, 0x34, 0x45, 0x43, 0x33, 0x45, 0x43, 0x33, 0x34,
+    0x33, 0x56, 0x24, 0x66, 0x42, 0x22, 0x66, 0x42, 0x22, 0x26, 0x22, 0x76, 0x14, 0x66, 0x41, 0x11,
+    0x66, 0x71, 0x11, 0x16, 0x11, 0x88, 0x04, 0x48, 0x80, 0x00, 0x45, 0x40, 0x00, 0x04, 0x00, 0x77,
+    0x27, 0x88, 0x82, 0x22, 0x77, 0x72, 0x22, 0x25, 0x22, 0x86, 0x18, 0x66, 0x81, 0x11, 0x66, 0x71,
+    0x11, 0x16, 0x11, 0x56, 0x07, 0x66, 0x30, 0x00, 0x66, 0x70, 0x00, 0x06, 0x00, 0x56, 0x88, 0x65,
+    0x56, 0x85, 0x65, 0x56, 0x25, 0x55, 0x56, 0x57, 0x77, 0x25, 0x58, 0x85, 0x75, 0x57, 0x75, 0x55,
+    0x52, 0x56, 0x08, 0x65, 0x56, 0x85, 0x65, 0x56, 0x75, 0x55, 0x56, 0x46, 0x23, 0x64, 0x42, 0x22,
+    0x64, 0x42, 0x22, 0x26, 0x22, 0x88, 0x18, 0x38, 0x81, 0x11, 0x74, 0x71, 0x11, 0x14, 0x11, 0x48,
+    0x08, 0x88, 0x80, 0x00, 0x34, 0x30, 0x00, 0x04, 0x00, 0x46, 0x12, 0x64, 0x46, 0x14, 0x64, 0x46,
+    0x24, 0x44, 0x46, 0x46, 0x02, 0x84, 0x46, 0x24, 0x24, 0x40, 0x04, 0x44, 0x40, 0x48, 0x88, 0x84,
+    0x40, 0x84, 0x14, 0x40, 0x04, 0x44, 0x40, 0x38, 0x88, 0x83, 0x38, 0x83, 0x23, 0x36, 0x73, 0x33,
+    0x36, 0x37, 0x72, 0x63, 0x30, 0x03, 0x73, 0x37, 0x73, 0x33, 0x36, 0x36, 0x81, 0x63, 0x36, 0x83,
+    0x63, 0x36, 0x03, 0x33, 0x36, 0x26, 0x01, 0x12, 0x10, 0x00, 0x12, 0x10, 0x00, 0x01, 0x00, 0x45,
+    0x23, 0x34, 0x32, 0x22, 0x35, 0x32, 0x22, 0x23, 0x22, 0x45, 0x13, 0x34, 0x31, 0x11, 0x34, 0x31,
+    0x11, 0x13, 0x11, 0x45, 0x03, 0x84, 0x40, 0x00, 0x34, 0x40, 0x00, 0x04, 0x00, 0x45, 0x12, 0x24,
+    0x21, 0x11, 0x24, 0x21, 0x11, 0x12, 0x11, 0x88, 0x08, 0x84, 0x40, 0x00, 0x24, 0x20, 0x00, 0x04,
+    0x00, 0x47, 0x08, 0x14, 0x40, 0x00, 0x14, 0x40, 0x00, 0x04, 0x00, 0x38, 0x82, 0x23, 0x28, 0x23,
+    0x23, 0x25, 0x23, 0x32, 0x22, 0x77, 0x72, 0x28, 0x20, 0x28, 0x27, 0x27, 0x27, 0x52, 0x22, 0x35,
+    0x01, 0x13, 0x10, 0x00, 0x13, 0x10, 0x00, 0x01, 0x00, 0x25, 0x01, 0x52, 0x20, 0x00, 0x52, 0x20,
+    0x00, 0x02, 0x00, 0x38, 0x87, 0x43, 0x34, 0x13, 0x43, 0x34, 0x23, 0x33, 0x32, 0x87, 0x08, 0x24,
+    0x84, 0x20, 0x44, 0x24, 0x00, 0x34, 0x02, 0x84, 0x88, 0x44, 0x84, 0x80, 0x44, 0x14, 0x00, 0x44,
+    0x04, 0x24, 0x01, 0x44, 0x10, 0x00, 0x44, 0x10, 0x00, 0x04, 0x00, 0x23, 0x01, 0x32, 0x23, 0x02,
+    0x32, 0x23, 0x02, 0x22, 0x23, 0x45, 0x23, 0x34, 0x42, 0x22, 0x54, 0x42, 0x22, 0x24, 0x22, 0x45,
+    0x13, 0x88, 0x41, 0x11, 0x64, 0x61, 0x11, 0x14, 0x11, 0x45, 0x03, 0x34, 0x40, 0x00, 0x34, 0x40,
+    0x00, 0x04, 0x00, 0x66, 0x66, 0x24, 0x41, 0x24, 0x66, 0x66, 0x66, 0x44, 0x22, 0x46, 0x68, 0x24,
+    0x40, 0x24, 0x24, 0x40, 0x04, 0x44, 0x40, 0x68, 0x68, 0x85, 0x40, 0x04, 0x14, 0x40, 0x06, 0x44,
+    0x10, 0x88, 0x18, 0x88, 0x81, 0x11, 0x25, 0x21, 0x11, 0x12, 0x11, 0x35, 0x02, 0x23, 0x20, 0x00,
+    0x23, 0x20, 0x00, 0x02, 0x00, 0x66, 0x61, 0x13, 0x10, 0x10, 0x16, 0x16, 0x16, 0x01, 0x11, 0x25,
+    0x01, 0x15, 0x15, 0x10, 0x15, 0x15, 0x12, 0x51, 0x11, 0x68, 0x68, 0x84, 0x24, 0x21, 0x43, 0x24,
+    0x26, 0x44, 0x21, 0x64, 0x66, 0x24, 0x24, 0x00, 0x44, 0x24, 0x00, 0x44, 0x04, 0x88, 0x88, 0x18,
+    0x88, 0x88, 0x44, 0x14, 0x00, 0x43, 0x00, 0x24, 0x01, 0x44, 0x24, 0x02, 0x44, 0x14, 0x00, 0x44,
+    0x04, 0x23, 0x01, 0x13, 0x13, 0x10, 0x13, 0x13, 0x10, 0x31, 0x11, 0x38, 0x88, 0x83, 0x38, 0x13,
+    0x43, 0x35, 0x53, 0x33, 0x32, 0x84, 0x88, 0x44, 0x84, 0x08, 0x44, 0x24, 0x00, 0x44, 0x04, 0x84,
+    0x88, 0x44, 0x84, 0x08, 0x44, 0x14, 0x00, 0x44, 0x04, 0x84, 0x08, 0x88, 0x80, 0x00, 0x12, 0x10,
+    0x00, 0x02, 0x00, 0x23, 0x81, 0x12, 0x18, 0x12, 0x12, 0x10, 0x12, 0x21, 0x11, 0x83, 0x88, 0x88,
+    0x88, 0x88, 0x12, 0x40, 0x44, 0x01, 0x00, 0x45, 0x23, 0x34, 0x42, 0x22, 0x64, 0x42, 0x22, 0x24,
+    0x22, 0x45, 0x13, 0x54, 0x41, 0x11, 0x34, 0x41, 0x11, 0x14, 0x11, 0x45, 0x03, 0x54, 0x30, 0x00,
+    0x55, 0x40, 0x00, 0x05, 0x00, 0x46, 0x66, 0x24, 0x41, 0x24, 0x64, 0x46, 0x64, 0x44, 0x41, 0x76,
+    0x62, 0x24, 0x40, 0x24, 0x24, 0x46, 0x00, 0x45, 0x02, 0x65, 0x76, 0x55, 0x45, 0x04, 0x55, 0x40,
+    0x14, 0x55, 0x05, 0x35, 0x12, 0x23, 0x21, 0x11, 0x23, 0x21, 0x11, 0x12, 0x11, 0x77, 0x07, 0x27,
+    0x70, 0x00, 0x66, 0x20, 0x00, 0x03, 0x00, 0x65, 0x06, 0x15, 0x30, 0x00, 0x55, 0x60, 0x00, 0x05,
+    0x00, 0x25, 0x01, 0x55, 0x20, 0x00, 0x55, 0x20, 0x00, 0x05, 0x00, 0x64, 0x62, 0x24, 0x24, 0x21,
+    0x24, 0x24, 0x21, 0x42, 0x22, 0x66, 0x62, 0x23, 0x20, 0x20, 0x24, 0x24, 0x26, 0x42, 0x22, 0x34,
+    0x01, 0x13, 0x10, 0x00, 0x13, 0x10, 0x00, 0x01, 0x00, 0x24, 0x01, 0x42, 0x24, 0x02, 0x42, 0x24,
+    0x10, 0x22, 0x24, 0x23, 0x01, 0x32, 0x10, 0x00, 0x32, 0x20, 0x00, 0x02, 0x00, 0x34, 0x77, 0x43,
+    0x34, 0x13, 0x43, 0x34, 0x13, 0x33, 0x34, 0x77, 0x77, 0x77, 0x77, 0x07, 0x24, 0x24, 0x50, 0x04,
+    0x34, 0x54, 0x55, 0x44, 0x74, 0x07, 0x44, 0x54, 0x50, 0x44, 0x14, 0x74, 0x07, 0x77, 0x70, 0x00,
+    0x12, 0x10, 0x00, 0x04, 0x00, 0x23, 0x07, 0x72, 0x20, 0x00, 0x12, 0x20, 0x00, 0x02, 0x00, 0x23,
+    0x77, 0x72, 0x27, 0x72, 0x12, 0x20, 0x42, 0x02, 0x21, 0x64, 0x66, 0x44, 0x64, 0x16, 0x44, 0x24,
+    0x21, 0x44, 0x24, 0x64, 0x66, 0x44, 0x64, 0x06, 0x24, 0x24, 0x00, 0x44, 0x24, 0x55, 0x55, 0x66,
+    0x66, 0x06, 0x15, 0x55, 0x55, 0x43, 0x30, 0x64, 0x66, 0x66, 0x66, 0x66, 0x12, 0x20, 0x02, 0x44,
+    0x24, 0x63, 0x01, 0x16, 0x10, 0x00, 0x12, 0x10, 0x00, 0x01, 0x00, 0x23, 0x66, 0x62, 0x26, 0x62,
+    0x12, 0x10, 0x02, 0x22, 0x20, 0x23, 0x01, 0x12, 0x10, 0x00, 0x12, 0x10, 0x00, 0x01, 0x00, 0x67,
+    0x45, 0x63, 0x45, 0x53, 0x34, 0x34, 0x73, 0x56, 0x24, 0x56, 0x24, 0x66, 0x42, 0x22, 0x67, 0x45,
+    0x61, 0x77, 0x61, 0x16, 0x14, 0x81, 0x88, 0x08, 0x56, 0x04, 0x45, 0x40, 0x00, 0x87, 0x88, 0x72,
+    0x77, 0x52, 0x23, 0x23, 0x82, 0x86, 0x18, 0x76, 0x17, 0x66, 0x31, 0x11, 0x67, 0x35, 0x60, 0x75,
+    0x60, 0x06, 0x03, 0x80, 0x56, 0x88, 0x56, 0x12, 0x65, 0x56, 0x15, 0x87, 0x85, 0x78, 0x75, 0x57,
+    0x02, 0x55, 0x80, 0x56, 0x88, 0x56, 0x77, 0x65, 0x56, 0x05, 0x67, 0x34, 0x62, 0x34, 0x62, 0x26,
+    0x23, 0x82, 0x86, 0x13, 0x77, 0x17, 0x34, 0x31, 0x11, 0x87, 0x84, 0x60, 0x34, 0x40, 0x03, 0x03,
+    0x70, 0x46, 0x12, 0x46, 0x12, 0x64, 0x46, 0x14, 0x67, 0x24, 0x60, 0x24, 0x40, 0x02, 0x44, 0x80,
+    0x46, 0x08, 0x46, 0x01, 0x14, 0x40, 0x04, 0x88, 0x83, 0x68, 0x73, 0x37, 0x66, 0x33, 0x71, 0x36,
+    0x02, 0x37, 0x72, 0x63, 0x36, 0x03, 0x67, 0x13, 0x68, 0x13, 0x30, 0x66, 0x33, 0x70, 0x26, 0x01,
+    0x26, 0x01, 0x12, 0x10, 0x00, 0x57, 0x34, 0x52, 0x34, 0x52, 0x23, 0x23, 0x72, 0x45, 0x13, 0x45,
+    0x13, 0x34, 0x31, 0x11, 0x57, 0x34, 0x50, 0x34, 0x40, 0x03, 0x04, 0x70, 0x45, 0x12, 0x45, 0x12,
+    0x24, 0x21, 0x11, 0x88, 0x88, 0x50, 0x24, 0x40, 0x02, 0x02, 0x70, 0x45, 0x01, 0x45, 0x01, 0x14,
+    0x40, 0x00, 0x88, 0x23, 0x58, 0x23, 0x31, 0x52, 0x32, 0x72, 0x88, 0x82, 0x77, 0x72, 0x25, 0x25,
+    0x20, 0x57, 0x13, 0x50, 0x13, 0x30, 0x01, 0x01, 0x70, 0x25, 0x01, 0x25, 0x01, 0x52, 0x20, 0x00,
+    0x47, 0x23, 0x41, 0x73, 0x31, 0x44, 0x33, 0x81, 0x84, 0x08, 0x34, 0x02, 0x44, 0x24, 0x00, 0x48,
+    0x83, 0x40, 0x13, 0x40, 0x44, 0x01, 0x70, 0x24, 0x01, 0x24, 0x01, 0x44, 0x10, 0x00, 0x37, 0x12,
+    0x30, 0x12, 0x20, 0x33, 0x22, 0x60, 0x45, 0x23, 0x45, 0x23, 0x34, 0x42, 0x22, 0x56, 0x34, 0x51,
+    0x34, 0x41, 0x13, 0x14, 0x61, 0x45, 0x03, 0x45, 0x03, 0x34, 0x40, 0x00, 0x56, 0x24, 0x61, 0x66,
+    0x46, 0x12, 0x12, 0x62, 0x45, 0x02, 0x45, 0x02, 0x24, 0x40, 0x04, 0x88, 0x84, 0x50, 0x14, 0x40,
+    0x01, 0x44, 0x80, 0x88, 0x18, 0x35, 0x12, 0x25, 0x21, 0x11, 0x56, 0x23, 0x50, 0x23, 0x30, 0x02,
+    0x02, 0x60, 0x35, 0x01, 0x66, 0x61, 0x13, 0x10, 0x10, 0x56, 0x12, 0x50, 0x12, 0x50, 0x51, 0x21,
+    0x61, 0x34, 0x12, 0x64, 0x62, 0x44, 0x24, 0x21, 0x46, 0x23, 0x40, 0x23, 0x40, 0x42, 0x02, 0x80,
+    0x84, 0x81, 0x34, 0x01, 0x13, 0x10, 0x00, 0x46, 0x12, 0x40, 0x12, 0x40, 0x44, 0x01, 0x60, 0x23,
+    0x01, 0x23, 0x01, 0x13, 0x13, 0x10, 0x88, 0x23, 0x51, 0x53, 0x35, 0x12, 0x33, 0x81, 0x84, 0x02,
+    0x34, 0x02, 0x44, 0x24, 0x00, 0x48, 0x18, 0x40, 0x13, 0x40, 0x44, 0x01, 0x50, 0x84, 0x08, 0x24,
+    0x01, 0x12, 0x10, 0x00, 0x35, 0x12, 0x38, 0x12, 0x20, 0x01, 0x21, 0x41, 0x83, 0x88, 0x23, 0x01,
+    0x12, 0x10, 0x00, 0x56, 0x34, 0x52, 0x34, 0x42, 0x23, 0x24, 0x62, 0x45, 0x13, 0x45, 0x13, 0x34,
+    0x41, 0x11, 0x56, 0x34, 0x50, 0x34, 0x40, 0x05, 0x03, 0x60, 0x45, 0x12, 0x46, 0x66, 0x24, 0x41,
+    0x14, 0x56, 0x24, 0x60, 0x24, 0x46, 0x02, 0x44, 0x72, 0x45, 0x71, 0x45, 0x01, 0x55, 0x40, 0x14,
+    0x56, 0x23, 0x51, 0x23, 0x31, 0x12, 0x12, 0x71, 0x75, 0x02, 0x66, 0x06, 0x23, 0x30, 0x00, 0x56,
+    0x13, 0x50, 0x66, 0x50, 0x01, 0x03, 0x60, 0x25, 0x01, 0x25, 0x01, 0x55, 0x20, 0x00, 0x46, 0x23,
+    0x41, 0x23, 0x41, 0x42, 0x12, 0x62, 0x34, 0x02, 0x66, 0x62, 0x23, 0x20, 0x20, 0x46, 0x13, 0x40,
+    0x13, 0x30, 0x01, 0x01, 0x60, 0x24, 0x01, 0x24, 0x01, 0x42, 0x24, 0x00, 0x36, 0x12, 0x30, 0x12,
+    0x20, 0x03, 0x01, 0x70, 0x34, 0x12, 0x34, 0x12, 0x43, 0x34, 0x13, 0x77, 0x27, 0x40, 0x53, 0x45,
+    0x44, 0x33, 0x50, 0x74, 0x01, 0x34, 0x05, 0x44, 0x14, 0x00, 0x45, 0x77, 0x40, 0x12, 0x20, 0x01,
+    0x01, 0x50, 0x23, 0x07, 0x23, 0x01, 0x12, 0x20, 0x00, 0x34, 0x72, 0x37, 0x12, 0x20, 0x01, 0x02,
+    0x61, 0x64, 0x12, 0x34, 0x12, 0x44, 0x24, 0x11, 0x46, 0x26, 0x40, 0x23, 0x40, 0x42, 0x02, 0x50,
+    0x66, 0x01, 0x54, 0x51, 0x13, 0x30, 0x03, 0x45, 0x66, 0x46, 0x12, 0x20, 0x01, 0x22, 0x50, 0x63,
+    0x01, 0x23, 0x01, 0x12, 0x10, 0x00, 0x34, 0x62, 0x36, 0x12, 0x20, 0x01, 0x21, 0x40, 0x23, 0x01,
+    0x23, 0x01, 0x12, 0x10, 0x00, 0x78, 0x56, 0x84, 0x67, 0x35, 0x78, 0x56, 0x82, 0x67, 0x15, 0x78,
+    0x56, 0x80, 0x67, 0x34, 0x78, 0x46, 0x82, 0x67, 0x14, 0x78, 0x46, 0x80, 0x67, 0x23, 0x78, 0x36,
+    0x81, 0x67, 0x03, 0x78, 0x26, 0x81, 0x67, 0x02, 0x78, 0x16, 0x80, 0x57, 0x34, 0x78, 0x45, 0x82,
+    0x57, 0x14, 0x78, 0x45, 0x80, 0x57, 0x23, 0x78, 0x35, 0x81, 0x57, 0x03, 0x78, 0x25, 0x81, 0x57,
+    0x02, 0x78, 0x15, 0x80, 0x47, 0x23, 0x78, 0x34, 0x81, 0x47, 0x03, 0x78, 0x24, 0x81, 0x47, 0x02,
+    0x78, 0x14, 0x80, 0x37, 0x12, 0x78, 0x23, 0x80, 0x37, 0x01, 0x78, 0x12, 0x80, 0x56, 0x34, 0x68,
+    0x45, 0x82, 0x56, 0x14, 0x68, 0x45, 0x80, 0x56, 0x23, 0x68, 0x35, 0x81, 0x56, 0x03, 0x68, 0x25,
+    0x81, 0x56, 0x02, 0x68, 0x15, 0x80, 0x46, 0x23, 0x68, 0x34, 0x81, 0x46, 0x03, 0x68, 0x24, 0x81,
+    0x46, 0x02, 0x68, 0x14, 0x80, 0x36, 0x12, 0x68, 0x23, 0x80, 0x36, 0x01, 0x68, 0x12, 0x80, 0x45,
+    0x23, 0x58, 0x34, 0x81, 0x45, 0x03, 0x58, 0x24, 0x81, 0x45, 0x02, 0x58, 0x14, 0x80, 0x35, 0x12,
+    0x58, 0x23, 0x80, 0x35, 0x01, 0x58, 0x12, 0x80, 0x34, 0x12, 0x48, 0x23, 0x80, 0x34, 0x01, 0x48,
+    0x12, 0x80, 0x23, 0x01, 0x67, 0x45, 0x73, 0x56, 0x24, 0x67, 0x45, 0x71, 0x56, 0x04, 0x67, 0x35,
+    0x72, 0x56, 0x13, 0x67, 0x35, 0x70, 0x56, 0x12, 0x67, 0x25, 0x70, 0x56, 0x01, 0x67, 0x34, 0x72,
+    0x46, 0x13, 0x67, 0x34, 0x70, 0x46, 0x12, 0x67, 0x24, 0x70, 0x46, 0x01, 0x67, 0x23, 0x71, 0x36,
+    0x02, 0x67, 0x13, 0x70, 0x26, 0x01, 0x57, 0x34, 0x72, 0x45, 0x13, 0x57, 0x34, 0x70, 0x45, 0x12,
+    0x57, 0x24, 0x70, 0x45, 0x01, 0x57, 0x23, 0x71, 0x35, 0x02, 0x57, 0x13, 0x70, 0x25, 0x01, 0x47,
+    0x23, 0x71, 0x34, 0x02, 0x47, 0x13, 0x70, 0x24, 0x01, 0x37, 0x12, 0x60, 0x45, 0x23, 0x56, 0x34,
+    0x61, 0x45, 0x03, 0x56, 0x24, 0x61, 0x45, 0x02, 0x56, 0x14, 0x60, 0x35, 0x12, 0x56, 0x23, 0x60,
+    0x35, 0x01, 0x56, 0x12, 0x60, 0x34, 0x12, 0x46, 0x23, 0x60, 0x34, 0x01, 0x46, 0x12, 0x60, 0x23,
+    0x01, 0x45, 0x23, 0x51, 0x34, 0x02, 0x45, 0x13, 0x50, 0x24, 0x01, 0x35, 0x12, 0x40, 0x23, 0x01
+};
+
+#endif // MOVE_TABLE_H
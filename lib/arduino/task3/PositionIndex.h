@@ -0,0 +1,90 @@
+/**
+ * @file PositionIndex.h
+ * @brief Dense index of every position in which the AI is to move.
+ *
+ * The AI plays 'O' and may move first ("ai" mode) or second ("player" mode),
+ * so it is to move whenever the player has as many marks as the AI or one more.
+ * Such positions are numbered group by group (AI marks, player marks), and
+ * inside a group by the colex rank of the AI cells followed by the colex rank
+ * of the player cells among the cells the AI left free. The index is computed
+ * in constant time and addresses the generated move table in MoveTable.h.
+ */
+#ifndef POSITION_INDEX_H
+#define POSITION_INDEX_H
+
+#include <stdint.h>
+#include "BitBoard.h"
+
+/// Number of indexed positions (full boards are left out, they have no reply).
+const uint16_t INDEXED_POSITIONS = 5920;
+
+/// Table entry meaning "no move stored for this position".
+const uint8_t NO_TABLE_MOVE = 0x0F;
+
+/// Binomial coefficients C(n, k) for n, k <= 9.
+const uint8_t BINOMIAL[10][10] PROGMEM = {
+    {1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 2, 1, 0, 0, 0, 0, 0, 0, 0},
+    {1, 3, 3, 1, 0, 0, 0, 0, 0, 0},
+    {1, 4, 6, 4, 1, 0, 0, 0, 0, 0},
+    {1, 5, 10, 10, 5, 1, 0, 0, 0, 0},
+    {1, 6, 15, 20, 15, 6, 1, 0, 0, 0},
+    {1, 7, 21, 35, 35, 21, 7, 1, 0, 0},
+    {1, 8, 28, 56, 70, 56, 28, 8, 1, 0},
+    {1, 9, 36, 84, 126, 126, 84, 36, 9, 1}
+};
+
+/// First index of each group, ordered by AI marks and then player marks (equal, one more).
+const uint16_t GROUP_OFFSET[5][2] PROGMEM = {
+    {0, 1},
+    {10, 82},
+    {334, 1090},
+    {2350, 4030},
+    {5290, 5920}
+};
+
+/**
+ * @brief Reads C(n, k) from flash.
+ * @param n Set size (0..9).
+ * @param k Subset size (0..9).
+ * @return The binomial coefficient.
+ */
+inline uint8_t binomial(uint8_t n, uint8_t k) {
+    return pgm_read_byte(&BINOMIAL[n][k]);
+}
+
+/**
+ * @brief Computes the table index of a position with the AI to move.
+ * @param b The position.
+ * @return Index in [0, INDEXED_POSITIONS), or -1 if the position is not indexed.
+ */
+inline int16_t positionIndex(BitBoard b) {
+    uint8_t aiMarks = bitCount(b.ai);
+    uint8_t playerMarks = bitCount(b.player);
+    if ((b.ai & b.player) != 0 || aiMarks > 4) return -1;
+    if (playerMarks < aiMarks || playerMarks > aiMarks + 1) return -1;
+    if (aiMarks + playerMarks == 9) return -1;
+
+    uint16_t aiRank = 0;
+    uint16_t playerRank = 0;
+    uint8_t aiSeen = 0;
+    uint8_t playerSeen = 0;
+    uint8_t freeCell = 0;
+    for (uint8_t cell = 0; cell < 9; cell++) {
+        uint16_t bit = (uint16_t)1 << cell;
+        if (b.ai & bit) {
+            aiRank += binomial(cell, ++aiSeen);
+            continue;
+        }
+        if (b.player & bit) {
+            playerRank += binomial(freeCell, ++playerSeen);
+        }
+        freeCell++;
+    }
+
+    uint16_t offset = pgm_read_word(&GROUP_OFFSET[aiMarks][playerMarks - aiMarks]);
+    return offset + aiRank * binomial(9 - aiMarks, playerMarks) + playerRank;
+}
+
+#endif // POSITION_INDEX_H
@@ -0,0 +1,258 @@
+/**
+ * @file Protocol.h
+ * @brief Binary framed UART protocol shared by the firmware and the client.
+ *
+ * The text protocol ("player\n", "r,c\n", a 9-character board line and
+ * result lines such as "AI win!") stays the default. Sending "bin\n" switches
+ * the firmware to fixed-size binary frames until a HELLO frame with version 0
+ * switches it back.
+ *
+ * Frame layout (FRAME_SIZE bytes):
+ *   byte 0  version (bits 7-6) | opcode (bits 5-3) | sequence number (bits 2-0)
+ *   byte 1-3 payload
+ *   byte 4  CRC-8 (polynomial 0x07) over bytes 0-3
+ *
+ * Payloads:
+ *   HELLO  p0 = protocol version (0 = back to text)
+ *   MODE   p0 = GameMode, p1 = AiTier (see AiMove.h; 0 = the original AI,
+ *          so older clients that leave it 0 are unaffected)
+ *   RESET  -
+ *   MOVE   p0 = cell (row * 3 + col)
+ *   LED    p0 = 0 blue, 1 yellow
+ *   BOARD  p0-p2 = 24-bit little-endian word: 2 bits per cell (bits 0-17,
+ *          Mark values), GameStatus in bits 18-20
+ *   DELTA  p0, p1 = moves applied since the last reply, (mark << 4) | cell,
+ *          0xFF when unused; p2 = GameStatus
+ *   NACK   p0 = NackReason
+ * Replies carry the sequence number of the command they answer. Frames that
+ * fail the check are dropped without a reply; the client retransmits after a
+ * timeout with the same sequence number and the firmware repeats its last
+ * reply instead of applying the command twice.
+ */
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+/// Current binary protocol version.
+const uint8_t PROTOCOL_VERSION = 1;
+
+/// Size of every binary frame in bytes.
+const uint8_t FRAME_SIZE = 5;
+
+/// Payload byte meaning "no move" in a DELTA frame.
+const uint8_t NO_DELTA = 0xFF;
+
+/**
+ * @enum Opcode
+ * @brief Frame types.
+ */
+enum Opcode : uint8_t {
+    OP_HELLO = 0, ///< Protocol switch / acknowledgement.
+    OP_MODE = 1,  ///< Start a game in a GameMode at an AiTier.
+    OP_RESET = 2, ///< Reset the board.
+    OP_MOVE = 3,  ///< Human move.
+    OP_LED = 4,   ///< Toggle an LED.
+    OP_BOARD = 5, ///< Full board and status.
+    OP_DELTA = 6, ///< Moves applied and status.
+    OP_NACK = 7   ///< Command rejected.
+};
+
+/**
+ * @enum GameStatus
+ * @brief Result of the game after a move; replaces the text result lines.
+ */
+enum GameStatus : uint8_t {
+    STATUS_PLAYING = 0, ///< Game goes on.
+    STATUS_X_WIN,       ///< "X win!" (PvP).
+    STATUS_O_WIN,       ///< "O win!" (PvP).
+    STATUS_AI_WIN,      ///< "AI win!".
+    STATUS_PLAYER_WIN,  ///< "You win!".
+    STATUS_DRAW         ///< "Draw!".
+};
+
+/**
+ * @enum GameMode
+ * @brief Game modes selected by the MODE frame (text "player", "ai", "pvp").
+ */
+enum GameMode : uint8_t {
+    MODE_PLAYER = 0, ///< Player moves first against the AI.
+    MODE_AI = 1,     ///< AI moves first.
+    MODE_PVP = 2     ///< Two players on one board.
+};
+
+/**
+ * @enum NackReason
+ * @brief Why a command was rejected.
+ */
+enum NackReason : uint8_t {
+    NACK_OPCODE = 1, ///< Unknown opcode or bad payload.
+    NACK_MOVE = 2    ///< Cell taken or game over.
+};
+
+/**
+ * @struct Frame
+ * @brief Decoded binary frame.
+ */
+struct Frame {
+    uint8_t opcode;     ///< Opcode value.
+    uint8_t seq;        ///< Sequence number (0-7).
+    uint8_t payload[3]; ///< Payload bytes.
+};
+
+/**
+ * @brief CRC-8 with polynomial 0x07 and initial value 0.
+ * @param data Bytes to check.
+ * @param length Number of bytes.
+ * @return The CRC.
+ */
+inline uint8_t crc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Serializes a frame.
+ * @param frame Frame to send.
+ * @param out Buffer of FRAME_SIZE bytes.
+ */
+inline void encodeFrame(const Frame& frame, uint8_t* out) {
+    out[0] = (uint8_t)((PROTOCOL_VERSION << 6) | ((frame.opcode & 0x07) << 3) | (frame.seq & 0x07));
+    out[1] = frame.payload[0];
+    out[2] = frame.payload[1];
+    out[3] = frame.payload[2];
+    out[4] = crc8(out, FRAME_SIZE - 1);
+}
+
+/**
+ * @brief Parses and validates a frame.
+ * @param in FRAME_SIZE received bytes.
+ * @param frame Filled on success.
+ * @return True if the version and CRC match.
+ */
+inline bool decodeFrame(const uint8_t* in, Frame& frame) {
+    if ((in[0] >> 6) != PROTOCOL_VERSION) return false;
+    if (crc8(in, FRAME_SIZE - 1) != in[FRAME_SIZE - 1]) return false;
+    frame.opcode = (in[0] >> 3) & 0x07;
+    frame.seq = in[0] & 0x07;
+    frame.payload[0] = in[1];
+    frame.payload[1] = in[2];
+    frame.payload[2] = in[3];
+    return true;
+}
+
+/**
+ * @brief Builds a frame.
+ * @param opcode Frame type.
+ * @param seq Sequence number.
+ * @param p0 Payload byte 0.
+ * @param p1 Payload byte 1.
+ * @param p2 Payload byte 2.
+ * @return The frame.
+ */
+inline Frame makeFrame(uint8_t opcode, uint8_t seq, uint8_t p0 = 0, uint8_t p1 = 0, uint8_t p2 = 0) {
+    Frame frame = {opcode, (uint8_t)(seq & 0x07), {p0, p1, p2}};
+    return frame;
+}
+
+/**
+ * @brief Packs a row-major board (' ', 'X', 'O') and a status into a BOARD payload.
+ * @param cells 9 cells.
+ * @param status Game status.
+ * @param payload 3 output bytes.
+ */
+inline void packBoard(const char* cells, uint8_t status, uint8_t* payload) {
+    uint32_t word = (uint32_t)(status & 0x07) << 18;
+    for (uint8_t i = 0; i < 9; i++) {
+        uint32_t mark = cells[i] == 'X' ? 1 : cells[i] == 'O' ? 2 : 0;
+        word |= mark << (2 * i);
+    }
+    payload[0] = (uint8_t)word;
+    payload[1] = (uint8_t)(word >> 8);
+    payload[2] = (uint8_t)(word >> 16);
+}
+
+/**
+ * @brief Unpacks a BOARD payload.
+ * @param payload 3 bytes.
+ * @param cells 9 output cells (' ', 'X', 'O').
+ * @return The game status.
+ */
+inline uint8_t unpackBoard(const uint8_t* payload, char* cells) {
+    uint32_t word = payload[0] | ((uint32_t)payload[1] << 8) | ((uint32_t)payload[2] << 16);
+    for (uint8_t i = 0; i < 9; i++) {
+        uint8_t mark = (word >> (2 * i)) & 0x03;
+        cells[i] = mark == 1 ? 'X' : mark == 2 ? 'O' : ' ';
+    }
+    return (word >> 18) & 0x07;
+}
+
+/**
+ * @brief Encodes one move of a DELTA frame.
+ * @param mark 'X' or 'O'.
+ * @param cell Cell index 0..8.
+ * @return (mark << 4) | cell.
+ */
+inline uint8_t packDelta(char mark, uint8_t cell) {
+    return (uint8_t)(((mark == 'X' ? 1 : 2) << 4) | (cell & 0x0F));
+}
+
+/**
+ * @brief Text line the text protocol prints for a status.
+ * @param status Game status.
+ * @return The line without newline, or 0 while the game goes on.
+ */
+inline const char* statusText(uint8_t status) {
+    switch (status) {
+        case STATUS_X_WIN: return "X win!";
+        case STATUS_O_WIN: return "O win!";
+        case STATUS_AI_WIN: return "AI win!";
+        case STATUS_PLAYER_WIN: return "You win!";
+        case STATUS_DRAW: return "Draw!";
+        default: return 0;
+    }
+}
+
+/**
+ * @struct FrameReader
+ * @brief Reassembles frames from a byte stream.
+ * Bytes are collected until FRAME_SIZE are buffered; a buffer that fails the
+ * check drops its first byte, so the reader resynchronizes after noise.
+ */
+struct FrameReader {
+    uint8_t buffer[FRAME_SIZE]; ///< Bytes of the frame being assembled.
+    uint8_t length;             ///< Bytes buffered.
+    uint16_t errors;            ///< Bytes dropped while resynchronizing.
+
+    FrameReader() : length(0), errors(0) {}
+
+    /**
+     * @brief Feeds one byte.
+     * @param byte Received byte.
+     * @param frame Filled when a valid frame is complete.
+     * @return True if frame holds a new frame.
+     */
+    bool push(uint8_t byte, Frame& frame) {
+        buffer[length++] = byte;
+        if (length < FRAME_SIZE) return false;
+        if (decodeFrame(buffer, frame)) {
+            length = 0;
+            return true;
+        }
+        for (uint8_t i = 1; i < FRAME_SIZE; i++) buffer[i - 1] = buffer[i];
+        length--;
+        errors++;
+        return false;
+    }
+
+    /// Drops a partial frame.
+    void reset() { length = 0; }
+};
+
+#endif // PROTOCOL_H
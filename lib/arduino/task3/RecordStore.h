@@ -0,0 +1,214 @@
+/**
+ * @file RecordStore.h
+ * @brief Wear-leveled, log-structured store of the LED settings and game results in EEPROM.
+ *
+ * The EEPROM is split into SLOTS fixed-size records. Every commit writes the
+ * whole state, with the next sequence number, into the slot after the newest
+ * one, so writes rotate over the entire EEPROM instead of wearing out fixed
+ * addresses, and the newest record is never overwritten. setup() recovers
+ * the state from the valid record with the highest sequence number.
+ *
+ * Changes only touch the copy in RAM. service(), called from loop(), commits
+ * them COMMIT_DELAY_MS after the first change, so a burst of toggles or a
+ * finished game costs one record. A commit writes one byte per service()
+ * call, and only when the EEPROM has finished the previous byte, so the
+ * 3.3 ms an AVR EEPROM write takes never stalls command handling. The
+ * sequence number is written last: a commit cut short by a reset leaves a
+ * record that fails its check or is older than the newest, never a torn
+ * newest record.
+ */
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#include <EEPROM.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef __AVR__
+#include <avr/eeprom.h>
+#endif
+
+/// Game modes with their own results, indexed by GameMode.
+const uint8_t RESULT_MODES = 3;
+
+/**
+ * @enum ResultKind
+ * @brief Outcome of a game, seen by the player (X in PvP).
+ */
+enum ResultKind : uint8_t {
+    RESULT_WIN = 0,
+    RESULT_DRAW = 1,
+    RESULT_LOSS = 2
+};
+
+/**
+ * @struct StoreRecord
+ * @brief One committed state, 22 bytes with no padding on AVR and hosts.
+ */
+struct StoreRecord {
+    uint16_t seq;                             ///< Commit number; 0xFFFF is never used (erased EEPROM).
+    uint16_t results[RESULT_MODES][3];        ///< [GameMode][ResultKind], saturating.
+    uint8_t leds;                             ///< Bit 0 blue, bit 1 yellow.
+    uint8_t check;                            ///< CRC-8 of the bytes before it.
+};
+
+/// EEPROM bytes used: the whole 1 KB of the Uno.
+const uint16_t STORE_BYTES = 1024;
+
+/**
+ * @class RecordStore
+ * @brief RAM copy of the state and the commit in progress.
+ */
+class RecordStore {
+public:
+    /// Records that fit into the EEPROM.
+    static const uint16_t SLOTS = STORE_BYTES / sizeof(StoreRecord);
+    /// Time from the first unsaved change to its commit.
+    static const unsigned long COMMIT_DELAY_MS = 1000;
+
+    RecordStore() : slot(SLOTS - 1), dirty(false), writing(false), changedAt(0), writeSlot(0), writePos(0), commits(0) {
+        memset(&current, 0, sizeof(current));
+    }
+
+    /**
+     * @brief Loads the newest valid record (setup()).
+     * Reads each slot once: SLOTS * 22 bytes.
+     * @return False if the EEPROM holds none; the state is then all zero.
+     */
+    bool recover() {
+        bool found = false;
+        StoreRecord record;
+        for (uint16_t i = 0; i < SLOTS; i++) {
+            EEPROM.get(i * sizeof(StoreRecord), record);
+            if (!valid(record)) continue;
+            if (!found || (int16_t)(record.seq - current.seq) > 0) {
+                current = record;
+                slot = i;
+                found = true;
+            }
+        }
+        if (!found) {
+            memset(&current, 0, sizeof(current));
+            slot = SLOTS - 1;
+        }
+        dirty = false;
+        writing = false;
+        return found;
+    }
+
+    /// @return LED bits: 0 blue, 1 yellow.
+    uint8_t leds() const { return current.leds; }
+
+    /**
+     * @brief Sets the LED bits; committed later by service().
+     * @param bits Bit 0 blue, bit 1 yellow.
+     * @param now Current millis().
+     */
+    void setLeds(uint8_t bits, unsigned long now) {
+        if (bits == current.leds) return;
+        current.leds = bits;
+        changed(now);
+    }
+
+    /**
+     * @brief Counts a finished game; committed later by service().
+     * @param mode GameMode of the game.
+     * @param kind ResultKind.
+     * @param now Current millis().
+     */
+    void addResult(uint8_t mode, uint8_t kind, unsigned long now) {
+        if (mode >= RESULT_MODES || kind > RESULT_LOSS) return;
+        uint16_t& count = current.results[mode][kind];
+        if (count != 0xFFFF) count++;
+        changed(now);
+    }
+
+    /// @return Games of a mode that ended with the given ResultKind.
+    uint16_t result(uint8_t mode, uint8_t kind) const { return current.results[mode][kind]; }
+
+    /**
+     * @brief Advances the commit: starts a due one, writes at most one byte.
+     * @param now Current millis().
+     */
+    void service(unsigned long now) {
+        if (!writing) {
+            if (!dirty || now - changedAt < COMMIT_DELAY_MS) return;
+            staged = current;
+            staged.seq = current.seq + 1 == 0xFFFF ? 0 : current.seq + 1;
+            staged.check = crc8((const uint8_t*)&staged, sizeof(StoreRecord) - 1);
+            writeSlot = (slot + 1) % SLOTS;
+            writePos = 0;
+            writing = true;
+            dirty = false;
+        }
+        const uint8_t* bytes = (const uint8_t*)&staged;
+        while (writePos < sizeof(StoreRecord)) {
+            if (!eepromReady()) return;
+            // Payload and check first, the sequence number last.
+            uint8_t offset = writePos < sizeof(StoreRecord) - 2 ? writePos + 2 : writePos - (sizeof(StoreRecord) - 2);
+            int address = writeSlot * sizeof(StoreRecord) + offset;
+            writePos++;
+            if (EEPROM.read(address) != bytes[offset]) {
+                EEPROM.write(address, bytes[offset]);
+                if (writePos < sizeof(StoreRecord)) return;
+            }
+        }
+        writing = false;
+        slot = writeSlot;
+        current.seq = staged.seq;
+        current.check = staged.check;
+        commits++;
+    }
+
+    /// @return True if every change is in the EEPROM.
+    bool idle() const { return !dirty && !writing; }
+
+    /// @return Sequence number of the newest record.
+    uint16_t sequence() const { return current.seq; }
+
+    /// @return Slot of the newest record.
+    uint16_t newestSlot() const { return slot; }
+
+    /// @return Commits finished since boot.
+    uint16_t commitCount() const { return commits; }
+
+private:
+    static bool eepromReady() {
+#ifdef __AVR__
+        return eeprom_is_ready();
+#else
+        return true;
+#endif
+    }
+
+    static uint8_t crc8(const uint8_t* data, uint8_t length) {
+        uint8_t crc = 0;
+        for (uint8_t i = 0; i < length; i++) {
+            crc ^= data[i];
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    static bool valid(const StoreRecord& record) {
+        return record.seq != 0xFFFF && record.check == crc8((const uint8_t*)&record, sizeof(StoreRecord) - 1);
+    }
+
+    void changed(unsigned long now) {
+        if (!dirty) changedAt = now;
+        dirty = true;
+    }
+
+    StoreRecord current;     ///< State in RAM; seq and check of the newest record.
+    StoreRecord staged;      ///< Record being written.
+    uint16_t slot;           ///< Slot of the newest record.
+    bool dirty;              ///< current has changes not staged yet.
+    bool writing;            ///< staged is being written.
+    unsigned long changedAt; ///< millis() of the first change not staged.
+    uint16_t writeSlot;      ///< Slot staged goes to.
+    uint8_t writePos;        ///< Bytes of staged written or skipped.
+    uint16_t commits;        ///< Commits since boot.
+};
+
+#endif // RECORD_STORE_H
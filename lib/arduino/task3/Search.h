@@ -0,0 +1,76 @@
+/**
+ * @file Search.h
+ * @brief Minimax search and move selection of the firmware AI.
+ */
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stdint.h>
+#include "BitBoard.h"
+#include "Transposition.h"
+
+/**
+ * @brief Minimax with alpha-beta pruning on a bitboard.
+ * Each frame holds the 4-byte position by value instead of a pointer to a
+ * shared board that has to be restored after every probe. As in the
+ * original firmware, bbIsMovesLeft() is true only for a full board, so every
+ * open position scores 0 right after the win checks.
+ * @param b The position.
+ * @param depth Current depth in the game tree.
+ * @param isMaximizing True if the AI is to move, false otherwise.
+ * @param alpha Alpha value for pruning.
+ * @param beta Beta value for pruning.
+ * @return The evaluated score of the position.
+ */
+inline int bbMinimax(BitBoard b, int depth, bool isMaximizing, int alpha, int beta) {
+    searchStats.nodes++;
+    if (depth > 9) return 0;
+    int score = bbEvaluate(b);
+
+    if (score == 1 || score == -1) return score;
+    if (!bbIsMovesLeft(b)) return 0;
+
+    int best = isMaximizing ? -1000 : 1000;
+    for (uint16_t empty = bbEmpty(b); empty; empty &= empty - 1) {
+        BitBoard next = bbPlace(b, isMaximizing, firstCell(empty));
+        int value = bbMinimax(next, depth + 1, !isMaximizing, alpha, beta);
+        if (isMaximizing) {
+            if (value > best) best = value;
+            if (best > alpha) alpha = best;
+        } else {
+            if (value < best) best = value;
+            if (best < beta) beta = best;
+        }
+        if (beta <= alpha) break;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Finds the best move for the AI: win, block, fork, then minimax plus cell priority.
+ * @param b The position.
+ * @return Cell index, or -1 if the board is full.
+ */
+inline int8_t bbFindBestMove(BitBoard b) {
+    int8_t move = firstCell(bbCellsScoring(b, true, 1));
+    if (move != -1) return move;
+    move = firstCell(bbCellsScoring(b, false, -1));
+    if (move != -1) return move;
+    move = bbFindForkMove(b, true);
+    if (move != -1) return move;
+
+    int bestVal = -1000;
+    for (uint16_t empty = bbEmpty(b); empty; empty &= empty - 1) {
+        uint8_t cell = firstCell(empty);
+        int moveVal = bbMinimax(bbPlace(b, true, cell), 0, false, -1000, 1000);
+        moveVal += POSITION_PRIORITY[cell];
+        if (moveVal > bestVal) {
+            move = cell;
+            bestVal = moveVal;
+        }
+    }
+    return move;
+}
+
+#endif // SEARCH_H
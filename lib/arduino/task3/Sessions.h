@@ -0,0 +1,128 @@
+/**
+ * @file Sessions.h
+ * @brief Fixed pool of packed game sessions multiplexed over one UART.
+ *
+ * A text command prefixed with "@<id> " (id 1..255), e.g. "@7 1,1", plays in
+ * session id instead of the default game; its replies carry the same prefix.
+ * The firmware loads the session into the game globals, runs the command as
+ * usual and packs the result back, so every command behaves exactly as it
+ * does for the default game. A session takes 7 bytes of SRAM on the Uno:
+ * the id, an LRU stamp and one 32-bit PackedGame. Sessions are
+ * created on first use; when the pool is full the least recently used one
+ * is evicted and its game is lost. Binary frames always address the
+ * default game.
+ */
+#ifndef SESSIONS_H
+#define SESSIONS_H
+
+#include <stdint.h>
+
+/**
+ * @struct PackedGame
+ * @brief State of one game in 32 bits.
+ */
+struct PackedGame {
+    uint32_t cells : 18;     ///< 2 bits per cell, row-major: 0 empty, 1 'X', 2 'O'.
+    uint32_t pvp : 1;        ///< Two-player game.
+    uint32_t xToMove : 1;    ///< PvP: X moves next.
+    uint32_t over : 1;       ///< Game finished.
+    uint32_t waiting : 1;    ///< Waiting for the human's move.
+    uint32_t moves : 4;      ///< Moves made, 0..9.
+    uint32_t status : 3;     ///< GameStatus after the last move.
+    uint32_t aiFirst : 1;    ///< Started with the AI moving first.
+    uint32_t tier : 2;       ///< AiTier of the game.
+
+    /// @return Mark of a cell as ' ', 'X' or 'O'.
+    char cell(uint8_t index) const {
+        uint8_t mark = (uint8_t)((cells >> (2 * index)) & 0x03);
+        return mark == 1 ? 'X' : mark == 2 ? 'O' : ' ';
+    }
+
+    /// Stores the marks of a row-major board.
+    void setCells(const char* board) {
+        uint32_t word = 0;
+        for (uint8_t i = 0; i < 9; i++) {
+            uint32_t mark = board[i] == 'X' ? 1 : board[i] == 'O' ? 2 : 0;
+            word |= mark << (2 * i);
+        }
+        cells = word;
+    }
+};
+
+/**
+ * @struct SessionSlot
+ * @brief One entry of the pool.
+ */
+struct SessionSlot {
+    uint8_t id;          ///< Session id, 0 if the slot is free.
+    uint16_t lastUsed;   ///< SessionPool clock at the last command.
+    PackedGame game;     ///< The session's game.
+};
+
+/**
+ * @class SessionPool
+ * @brief Finds, creates and evicts sessions.
+ * @tparam Slots Number of sessions kept at once.
+ */
+template<uint8_t Slots>
+class SessionPool {
+public:
+    SessionPool() : evictions(0), clock(0) {
+        for (uint8_t i = 0; i < Slots; i++) slots[i].id = 0;
+    }
+
+    /**
+     * @brief Returns the slot of a session, creating it with an empty game if needed.
+     * A new session takes a free slot or evicts the least recently used one.
+     * @param id Session id, 1..255.
+     * @return The slot.
+     */
+    SessionSlot& acquire(uint8_t id) {
+        clock++;
+        uint8_t victim = 0;
+        uint16_t oldest = 0;
+        for (uint8_t i = 0; i < Slots; i++) {
+            if (slots[i].id == id) {
+                slots[i].lastUsed = clock;
+                return slots[i];
+            }
+            uint16_t age = slots[i].id == 0 ? 0xFFFF : (uint16_t)(clock - slots[i].lastUsed);
+            if (age > oldest || i == 0) {
+                oldest = age;
+                victim = i;
+            }
+        }
+        SessionSlot& slot = slots[victim];
+        if (slot.id != 0) evictions++;
+        slot.id = id;
+        slot.lastUsed = clock;
+        slot.game = PackedGame();
+        slot.game.xToMove = 1;
+        return slot;
+    }
+
+    /// @return Sessions in use.
+    uint8_t active() const {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < Slots; i++) {
+            if (slots[i].id != 0) count++;
+        }
+        return count;
+    }
+
+    /// @return Number of slots.
+    uint8_t capacity() const { return Slots; }
+
+    /// Frees every slot.
+    void clear() {
+        for (uint8_t i = 0; i < Slots; i++) slots[i].id = 0;
+    }
+
+    uint16_t evictions; ///< Sessions dropped to make room for new ones.
+
+private:
+    SessionSlot slots[Slots];
+    uint16_t clock; ///< Bumped on every acquire().
+};
+
+#endif // SESSIONS_H
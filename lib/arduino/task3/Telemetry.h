@@ -0,0 +1,49 @@
+/**
+ * @file Telemetry.h
+ * @brief Counters and micros() timings of the firmware hot path.
+ *
+ * The production build keeps these up to date on the board and prints them
+ * for the "stats" command, so latencies can be read from a board in the
+ * field without the test build. Everything is fixed-size; updating a timing
+ * costs a few comparisons and one addition.
+ */
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+/**
+ * @struct TimingStat
+ * @brief Minimum, maximum and total of a duration in microseconds.
+ */
+struct TimingStat {
+    uint32_t count;       ///< Samples taken.
+    unsigned long min;    ///< Shortest sample.
+    unsigned long max;    ///< Longest sample.
+    unsigned long total;  ///< Sum of all samples (wraps after about 71 minutes of busy time).
+
+    /// Adds one sample.
+    void add(unsigned long us) {
+        if (count == 0 || us < min) min = us;
+        if (us > max) max = us;
+        total += us;
+        count++;
+    }
+
+    /// @return Average sample, 0 if there is none.
+    unsigned long average() const { return count == 0 ? 0 : total / count; }
+};
+
+/**
+ * @struct Telemetry
+ * @brief Everything the "stats" command reports.
+ */
+struct Telemetry {
+    TimingStat command;     ///< Handling of one text command or binary frame.
+    TimingStat search;      ///< AI move (table lookup and search fallback).
+    uint32_t rxFull;        ///< Times the serial RX buffer was found full (bytes may be lost).
+    uint32_t parseErrors;   ///< Rejected text lines: overlong, a malformed "@<id>" prefix or an unknown command.
+                            ///< Bytes dropped from binary frames are counted by FrameReader (frame_err).
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,139 @@
+/**
+ * @file Transposition.h
+ * @brief Symmetry-aware position hashing and a fixed-size transposition table for the 3 x 3 search.
+ *
+ * The eight rotations and reflections of a board have the same value, so
+ * every position is reduced to a canonical key (the smallest packed form
+ * over the dihedral group) before it is looked up. The table is a plain
+ * always-replace array of TT_SIZE entries (a power of two): 16 entries
+ * (160 bytes of SRAM) on AVR, 4096 on the host.
+ *
+ * The table sits in front of the negamax of BoardSearch<3, 3> (TIER_HARD),
+ * which descends into open positions. The legacy minimax in Search.h does
+ * not use it: with the firmware's isMovesLeft() convention it returns 0 at
+ * the first open position, so no position would ever be found again.
+ */
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <stdint.h>
+#include "BitBoard.h"
+
+#ifndef TT_SIZE
+#ifdef __AVR__
+#define TT_SIZE 16
+#else
+#define TT_SIZE 4096
+#endif
+#endif
+
+/// Number of board symmetries (4 rotations, 4 reflections).
+const uint8_t SYMMETRY_COUNT = 8;
+
+/// Image of each cell under every symmetry; entry 0 is the identity.
+const uint8_t SYMMETRY_MAP[SYMMETRY_COUNT][9] PROGMEM = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8}, // identity
+    {2, 5, 8, 1, 4, 7, 0, 3, 6}, // rotate 90
+    {8, 7, 6, 5, 4, 3, 2, 1, 0}, // rotate 180
+    {6, 3, 0, 7, 4, 1, 8, 5, 2}, // rotate 270
+    {2, 1, 0, 5, 4, 3, 8, 7, 6}, // mirror columns
+    {6, 7, 8, 3, 4, 5, 0, 1, 2}, // mirror rows
+    {0, 3, 6, 1, 4, 7, 2, 5, 8}, // main diagonal
+    {8, 5, 2, 7, 4, 1, 6, 3, 0}  // anti-diagonal
+};
+
+/**
+ * @enum TTFlag
+ * @brief Kind of value stored in a transposition table entry.
+ */
+enum TTFlag : uint8_t {
+    TT_EMPTY = 0, ///< Slot not used yet.
+    TT_EXACT,     ///< Exact minimax value.
+    TT_LOWER,     ///< Search failed high, the value is a lower bound.
+    TT_UPPER      ///< Search failed low, the value is an upper bound.
+};
+
+/**
+ * @struct TTEntry
+ * @brief One slot of the transposition table.
+ */
+struct TTEntry {
+    uint32_t key;  ///< Canonical key of the stored position.
+    int32_t value; ///< Stored value or bound, win scores relative to the node.
+    uint8_t depth; ///< Remaining depth of the search that stored it.
+    TTFlag flag;   ///< Meaning of value.
+};
+
+/**
+ * @struct SearchStats
+ * @brief Work counters of the legacy minimax and of the table.
+ */
+struct SearchStats {
+    uint32_t nodes;    ///< Minimax calls.
+    uint32_t ttProbes; ///< Table lookups.
+    uint32_t ttHits;   ///< Lookups that returned a value without searching.
+};
+
+static SearchStats searchStats = {0, 0, 0}; ///< Counters since the last resetSearchStats().
+static TTEntry transpositionTable[TT_SIZE]; ///< The transposition table.
+static bool ttEnabled = true;               ///< Set to false to measure the search without the table.
+
+/**
+ * @brief Applies a symmetry to a cell mask.
+ * @param mask Cell mask.
+ * @param symmetry Index into SYMMETRY_MAP.
+ * @return The transformed mask.
+ */
+inline uint16_t transformMask(uint16_t mask, uint8_t symmetry) {
+    uint16_t result = 0;
+    for (uint8_t cell = 0; cell < 9; cell++) {
+        if (mask & ((uint16_t)1 << cell)) {
+            result |= (uint16_t)1 << pgm_read_byte(&SYMMETRY_MAP[symmetry][cell]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Maps a position to the key shared by all of its symmetric variants.
+ * @param b The position.
+ * @param aiToMove Side to move, part of the key.
+ * @return AI mask in bits 0-8, player mask in bits 9-17, side to move in bit 18.
+ */
+inline uint32_t canonicalKey(BitBoard b, bool aiToMove) {
+    uint32_t best = 0xFFFFFFFFUL;
+    for (uint8_t s = 0; s < SYMMETRY_COUNT; s++) {
+        uint32_t key = transformMask(b.ai, s) | ((uint32_t)transformMask(b.player, s) << 9);
+        if (key < best) best = key;
+    }
+    return best | ((uint32_t)aiToMove << 18);
+}
+
+/**
+ * @brief Returns the slot a key maps to.
+ * @param key Canonical key.
+ * @return Reference to the table entry.
+ */
+inline TTEntry& ttSlot(uint32_t key) {
+    return transpositionTable[(key ^ (key >> 9) ^ (key >> 13)) & (TT_SIZE - 1)];
+}
+
+/**
+ * @brief Clears the transposition table.
+ */
+inline void clearTranspositionTable() {
+    for (uint16_t i = 0; i < TT_SIZE; i++) {
+        transpositionTable[i].flag = TT_EMPTY;
+    }
+}
+
+/**
+ * @brief Resets the search counters.
+ */
+inline void resetSearchStats() {
+    searchStats.nodes = 0;
+    searchStats.ttProbes = 0;
+    searchStats.ttHits = 0;
+}
+
+#endif // TRANSPOSITION_H
@@ -0,0 +1,85 @@
+/**
+ * @file task3.h
+ * @brief Declarations of the Tic-Tac-Toe firmware functions.
+ *
+ * The Arduino IDE generates these prototypes on its own; the header lets the
+ * sketch also be compiled as plain C++ on the host (see lib/host).
+ */
+#ifndef TASK3_H
+#define TASK3_H
+
+#include <stdint.h>
+#include "BitBoard.h"
+#include "Protocol.h"
+#include "Telemetry.h"
+#include "Ingest.h"
+#include "Sessions.h"
+#include "RecordStore.h"
+#include "AiMove.h"
+
+/**
+ * @struct Pair
+ * @brief Represents a pair of coordinates (row and column) for the game board.
+ */
+struct Pair {
+    int first;///< Row index
+    int second;///< Column index
+};
+
+void setup();
+void loop();
+void drainSerial();
+void handleInput();
+void processCommand();
+bool handleLinkCommand(const char* text);
+void switchBaud(uint32_t rate);
+const char* parseSessionId(const char* text, uint8_t& id);
+void enterSession(uint8_t id);
+void leaveSession();
+void saveGame(PackedGame& game);
+void loadGame(const PackedGame& game);
+void printSessionPrefix();
+void toggleBlueLed();
+void toggleYellowLed();
+void enterBinaryMode();
+void resetGame();
+void startPlayerGame();
+void startAIGame();
+void startPvPGame();
+void setAiTier(AiTier tier);
+void setNormalTier();
+void setHardTier();
+void setEasyTier();
+void handleMoveCommand(int row, int col);
+void processFrame(const Frame& frame);
+void printTiming(const __FlashStringHelper* name, const TimingStat& stat);
+void sendStats();
+void sendResults();
+int freeRam();
+void sendFrame(const Frame& frame);
+void startGame(GameMode mode);
+bool playMove(int row, int col);
+GameStatus finishMove();
+void recordResult(GameStatus status);
+void saveLedStateToEEPROM();
+void loadLedStateFromEEPROM();
+bool isAIMoveWinning();
+Pair makeAIMove();
+void resetBoard();
+void sendCurrentBoardState();
+bool checkWinner();
+void BlueblinkLED();
+void YellowblinkLED();
+void DrawblinkLED();
+BitBoard toBitBoard(char board[3][3]);
+Pair cellToPair(int8_t cell);
+int evaluate(char board[3][3]);
+bool isMovesLeft(char board[3][3]);
+bool canCreateFork(char board[3][3], char playerSymbol);
+int minimax(char board[3][3], int depth, bool isMaximizing, int alpha, int beta);
+Pair findBestMove(char board[3][3]);
+Pair findWinningMove(char board[3][3], char playerSymbol);
+Pair findBlockingMove(char board[3][3], char opponent);
+Pair findForkMove(char board[3][3], char playerSymbol);
+
+#endif // TASK3_H
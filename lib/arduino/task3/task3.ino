@@ -1,19 +1,31 @@
 /**
  * @file main.ino
  * @brief Arduino backend for Tic-Tac-Toe game with AI and LED indicators.
+ *
+ * The default build is the production firmware. Defining TASK3_UNIT_TESTS
+ * (e.g. "make firmware_test") builds the AUnit test sketch instead: loop()
+ * then runs the tests in test.ino before handling serial input.
  */
 #include <Arduino.h>
 #include <EEPROM.h> 
+#ifdef TASK3_UNIT_TESTS
 #include <AUnit.h>
-
-/**
- * @struct Pair
- * @brief Represents a pair of coordinates (row and column) for the game board.
- */
-struct Pair {
-    int first;///< Row index
-    int second;///< Column index
-};
+#endif
+#include "task3.h"
+#include "BitBoard.h"
+#include "Search.h"
+#include "AiMove.h"
+#include "Protocol.h"
+#include "Effects.h"
+#include "Telemetry.h"
+#include "Ingest.h"
+#include "Sessions.h"
+#include "RecordStore.h"
+#include "Link.h"
+
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 64 ///< HardwareSerial RX buffer of the Uno.
+#endif
 
 /// Pin for the blue LED.
 const int BlueledPin = 8; 
@@ -21,12 +33,21 @@ const int BlueledPin = 8;
 /// Pin for the yellow LED.
 const int YellowledPin = 9;
 
+/// Duration of one LED blink in milliseconds.
+const unsigned long BLINK_MS = 300;
+
 /// Buffer for incoming serial data.
 char receivedData[20];
 
 /// Index for the serial data buffer.
 int dataIndex = 0;
 
+/// Commands handled per loop() before the LED effects get serviced again.
+const uint8_t COMMANDS_PER_LOOP = 4;
+
+/// Games kept for "@<id>" sessions besides the default one.
+const uint8_t SESSION_SLOTS = 24;
+
 /// Game board (3x3 grid).
 char board[3][3] = {{' ', ' ', ' '}, {' ', ' ', ' '}, {' ', ' ', ' '}}; // gameBoard
 bool gameOver = false; ///< Flag to indicate if the game is over.
@@ -41,6 +62,54 @@ bool pvpmode = false; ///< Flag for Player vs Player mode.
 bool playerTurn = true; ///< Current player's turn (true = Player X, false = Player O).
 bool blueLedState = false; ///< State of the blue LED.
 bool yellowLedState = false; ///< State of the yellow LED.
+bool binaryMode = false; ///< True after "bin": commands and replies are binary frames.
+FrameReader frameReader; ///< Reassembles incoming binary frames.
+GameStatus lastStatus = STATUS_PLAYING; ///< Status after the last move.
+GameMode gameMode = MODE_PLAYER; ///< Mode of the running game, for its result.
+AiTier aiTier = TIER_NORMAL; ///< AI tier of the running game and the games after it.
+uint8_t lastDelta[2] = {NO_DELTA, NO_DELTA}; ///< Moves applied by the last playMove(), DELTA encoding.
+uint8_t replySeq = 0; ///< Sequence number of the frame being answered.
+uint8_t lastReply[FRAME_SIZE]; ///< Last frame sent, repeated for retransmitted commands.
+int16_t lastCommand = -1; ///< Header byte of the last frame handled, -1 if none.
+EffectScheduler<4> effects; ///< Pending LED writes, serviced from loop().
+Telemetry telemetry; ///< Hot-path counters reported by the "stats" command.
+ByteRing<64> rxRing; ///< Bytes drained from Serial, not handled yet.
+bool lineTooLong = false; ///< The text line being received overflowed receivedData.
+SessionPool<SESSION_SLOTS> sessions; ///< Games of the "@<id>" sessions (see Sessions.h).
+uint8_t activeSession = 0; ///< Session the current command plays in, 0 = the default game.
+SessionSlot* sessionSlot = 0; ///< Slot of activeSession.
+PackedGame defaultGame; ///< The default game while a session is loaded.
+RecordStore recordStore; ///< LED settings and game results in EEPROM (see RecordStore.h).
+LinkSpeed linkSpeed; ///< Serial rate negotiated with the client (see Link.h).
+uint16_t linkErrors = 0; ///< Non-printable bytes in text lines and garbled "sync" patterns.
+
+/// Names of the text commands, in flash; the tier commands use AI_TIER_NAMES.
+const char COMMAND_BLUE_LED[] PROGMEM = "BLed";
+const char COMMAND_YELLOW_LED[] PROGMEM = "Yled";
+const char COMMAND_BINARY[] PROGMEM = "bin";
+const char COMMAND_RESET[] PROGMEM = "reset";
+const char COMMAND_STATS[] PROGMEM = "stats";
+const char COMMAND_RESULTS[] PROGMEM = "results";
+const char COMMAND_PLAYER[] PROGMEM = "player";
+const char COMMAND_AI[] PROGMEM = "ai";
+const char COMMAND_PVP[] PROGMEM = "pvp";
+
+/// Text commands, in flash; moves ("r,c") are matched separately.
+const CommandEntry COMMANDS[] PROGMEM = {
+    {COMMAND_BLUE_LED, toggleBlueLed},
+    {COMMAND_YELLOW_LED, toggleYellowLed},
+    {COMMAND_BINARY, enterBinaryMode},
+    {COMMAND_RESET, resetGame},
+    {COMMAND_STATS, sendStats},
+    {COMMAND_RESULTS, sendResults},
+    {COMMAND_PLAYER, startPlayerGame},
+    {COMMAND_AI, startAIGame},
+    {COMMAND_PVP, startPvPGame},
+    {AI_TIER_NAME_NORMAL, setNormalTier},
+    {AI_TIER_NAME_HARD, setHardTier},
+    {AI_TIER_NAME_EASY, setEasyTier},
+};
+CommandTable<16> commandTable(COMMANDS, sizeof(COMMANDS) / sizeof(COMMANDS[0])); ///< Hashed lookup of COMMANDS.
 
 
 /**
@@ -48,7 +117,7 @@ bool yellowLedState = false; ///< State of the yellow LED.
  * Initializes the serial communication, pins, and loads LED states.
  */
 void setup(){
-    Serial.begin(9600);
+    Serial.begin(LINK_DEFAULT_BAUD);
     pinMode(BlueledPin, OUTPUT);
     pinMode(YellowledPin, OUTPUT);
     loadLedStateFromEEPROM(); 
@@ -61,24 +130,79 @@ void setup(){
 
 /**
  * @brief Arduino main loop.
- * Handles serial input and game logic.
+ * Services the LED effects, drains the serial input and handles the
+ * commands it completes.
  */
 void loop() {
+#ifdef TASK3_UNIT_TESTS
     aunit::TestRunner::setVerbosity(aunit::Verbosity::kAll);
-    Serial.println("Starting AUnit tests...");
+    Serial.println(F("Starting AUnit tests..."));
     aunit::TestRunner::run();
-    
-    if (Serial.available() > 0) {
-        char receivedChar = Serial.read();
-        if (receivedChar == '\n') {
-            receivedData[dataIndex] = '\0';
-            processCommand(); 
-            dataIndex = 0;    
-        } else if (dataIndex < sizeof(receivedData) - 1) {
-            receivedData[dataIndex++] = receivedChar;
+#endif
+    effects.service(millis());
+    drainSerial();
+    handleInput();
+    recordStore.service(millis());
+    uint32_t fallback = linkSpeed.service(millis(), linkErrors + frameReader.errors);
+    if (fallback != 0) {
+        binaryMode = false;
+        switchBaud(fallback);
+    }
+}
+
+/**
+ * @brief Moves every byte Serial has received into rxRing.
+ * Bytes that do not fit stay in the UART buffer for the next loop().
+ */
+void drainSerial() {
+    int pending = Serial.available();
+    if (pending >= SERIAL_RX_BUFFER_SIZE - 1) {
+        telemetry.rxFull++;
+    }
+    while (pending-- > 0 && !rxRing.full()) {
+        rxRing.push((uint8_t)Serial.read());
+    }
+}
+
+/**
+ * @brief Handles up to COMMANDS_PER_LOOP complete commands from rxRing.
+ * Text lines longer than receivedData are dropped up to their newline and
+ * answered with an error; binary bytes go to the frame reader.
+ */
+void handleInput() {
+    uint8_t handled = 0;
+    uint8_t byte;
+    while (handled < COMMANDS_PER_LOOP && rxRing.pop(byte)) {
+        if (!binaryMode && (byte < ' ' || byte > '~') && byte != '\n' && byte != '\r') {
+            linkErrors++;
+        }
+        if (binaryMode) {
+            Frame frame;
+            if (frameReader.push(byte, frame)) {
+                unsigned long started = micros();
+                processFrame(frame);
+                telemetry.command.add(micros() - started);
+                handled++;
+            }
+        } else if (byte == '\n') {
+            if (lineTooLong) {
+                Serial.println(F("Error: Command too long!"));
+                telemetry.parseErrors++;
+                lineTooLong = false;
+            } else {
+                receivedData[dataIndex] = '\0';
+                unsigned long started = micros();
+                processCommand();
+                telemetry.command.add(micros() - started);
+                handled++;
+            }
+            dataIndex = 0;
+        } else if (lineTooLong) {
+            continue;
+        } else if (dataIndex < (int)sizeof(receivedData) - 1) {
+            receivedData[dataIndex++] = (char)byte;
         } else {
-            dataIndex = 0; 
-            memset(receivedData, 0, sizeof(receivedData));
+            lineTooLong = true;
         }
     }
 }
@@ -86,130 +210,536 @@ void loop() {
 
 /**
  * @brief Processes the received command.
- * Interprets and executes commands sent via serial communication.
+ * An "@<id> " prefix runs the command in that session. The command is looked
+ * up in commandTable; anything else must be a move "r,c".
  */
 void processCommand() {
-    if (strlen(receivedData) > 9) {
-        Serial.println("Error: Command too long!");
+    if (handleLinkCommand(receivedData)) {
+        memset(receivedData, 0, sizeof(receivedData));
+        return;
+    }
+    const char* text = receivedData;
+    uint8_t session = 0;
+    if (text[0] == '@') {
+        text = parseSessionId(text + 1, session);
+    }
+    if (text == 0 || strlen(text) > 9) {
+        if (text != 0) Serial.println(F("Error: Command too long!"));
+        telemetry.parseErrors++;
         memset(receivedData, 0, sizeof(receivedData)); 
         return;
     }
 
-    if (strcmp(receivedData, "BLed") == 0) {
-        BlueblinkLED();
-        blueLedState = !blueLedState; 
-        saveLedStateToEEPROM(); 
-        
-    } 
-    if (strcmp(receivedData, "Yled") == 0) {
-        YellowblinkLED();
-        yellowLedState = !yellowLedState; 
-        saveLedStateToEEPROM(); 
-        
-    } 
-    if (strcmp(receivedData, "reset") == 0) {
-        DrawblinkLED();
-        resetBoard();
-        waitingForPlayerMove = false;
-        pvpmode = false; 
-        playerTurn = true; 
+    if (session != 0) enterSession(session);
+    CommandHandler handler = commandTable.find(text);
+    if (handler != 0) {
+        handler();
+    } else if (text[1] == ',' && text[0] >= '0' &&
+               text[0] <= '2' && text[2] >= '0' &&
+               text[2] <= '2') {
+        handleMoveCommand(text[0] - '0', text[2] - '0');
+    } else {
+        telemetry.parseErrors++;
+    }
+    if (session != 0) leaveSession();
+    memset(receivedData, 0, sizeof(receivedData));
+}
+
+/**
+ * @brief Handles the link commands (see Link.h), which are longer than the others:
+ * "baud" lists the rates, "baud <rate>" switches to one on trial, "baud ok"
+ * confirms it and "sync <pattern>" echoes the line.
+ * @param text The received line.
+ * @return False if the line is not a link command.
+ */
+bool handleLinkCommand(const char* text) {
+    if (strncmp_P(text, PSTR("sync "), 5) == 0) {
+        if (strcmp_P(text + 5, LINK_PATTERN) != 0) linkErrors++;
+        Serial.println(text);
+        return true;
+    }
+    if (strncmp_P(text, PSTR("baud"), 4) != 0 || (text[4] != '\0' && text[4] != ' ')) {
+        return false;
+    }
+    if (text[4] == '\0') {
+        Serial.print(F("baud"));
+        for (uint8_t i = 0; i < LINK_RATE_COUNT; i++) {
+            Serial.print(' ');
+            Serial.print(linkRate(i));
+        }
+        Serial.println();
+    } else if (strcmp_P(text + 5, PSTR("ok")) == 0) {
+        Serial.println(linkSpeed.confirm() ? F("baud ok") : F("baud no"));
+    } else {
+        uint32_t rate = strtoul(text + 5, 0, 10);
+        if (!linkSpeed.startTrial(rate, millis())) {
+            Serial.println(F("baud no"));
+            return true;
+        }
+        Serial.print(F("baud "));
+        Serial.print(rate);
+        Serial.println(F(" ok"));
+        switchBaud(rate);
+    }
+    return true;
+}
+
+/**
+ * @brief Sends what is queued at the old rate, then reopens the UART at a new one.
+ * A partial text line or frame from before the switch is dropped.
+ * @param rate New baud rate.
+ */
+void switchBaud(uint32_t rate) {
+    Serial.flush();
+    Serial.begin(rate);
+    dataIndex = 0;
+    lineTooLong = false;
+    frameReader.reset();
+}
+
+/**
+ * @brief Parses the id of an "@<id> " prefix.
+ * @param text Text after the '@'.
+ * @param id Set to the id.
+ * @return The command after the prefix, or 0 if the id is not 1..255 followed by a space.
+ */
+const char* parseSessionId(const char* text, uint8_t& id) {
+    unsigned int value = 0;
+    uint8_t digits = 0;
+    while (*text >= '0' && *text <= '9' && digits < 3) {
+        value = value * 10 + (*text++ - '0');
+        digits++;
+    }
+    if (digits == 0 || *text != ' ' || value == 0 || value > 255) {
+        return 0;
+    }
+    id = (uint8_t)value;
+    return text + 1;
+}
+
+/**
+ * @brief Swaps a session's game into the game globals.
+ * The default game waits in defaultGame until leaveSession().
+ * @param id Session id.
+ */
+void enterSession(uint8_t id) {
+    saveGame(defaultGame);
+    sessionSlot = &sessions.acquire(id);
+    loadGame(sessionSlot->game);
+    activeSession = id;
+}
+
+/**
+ * @brief Packs the session's game back and restores the default game.
+ */
+void leaveSession() {
+    saveGame(sessionSlot->game);
+    loadGame(defaultGame);
+    activeSession = 0;
+    sessionSlot = 0;
+}
+
+/**
+ * @brief Packs the game globals.
+ * @param game Receives the game.
+ */
+void saveGame(PackedGame& game) {
+    game.setCells(&board[0][0]);
+    game.pvp = pvpmode;
+    game.xToMove = playerTurn;
+    game.over = gameOver;
+    game.waiting = waitingForPlayerMove;
+    game.moves = moveCount;
+    game.status = lastStatus;
+    game.aiFirst = gameMode == MODE_AI;
+    game.tier = aiTier;
+}
+
+/**
+ * @brief Unpacks a game into the game globals.
+ * @param game The game.
+ */
+void loadGame(const PackedGame& game) {
+    for (uint8_t i = 0; i < 9; i++) {
+        board[i / 3][i % 3] = game.cell(i);
+    }
+    pvpmode = game.pvp;
+    playerTurn = game.xToMove;
+    gameOver = game.over;
+    waitingForPlayerMove = game.waiting;
+    moveCount = game.moves;
+    lastStatus = (GameStatus)game.status;
+    gameMode = game.pvp ? MODE_PVP : game.aiFirst ? MODE_AI : MODE_PLAYER;
+    aiTier = game.tier < AI_TIER_COUNT ? (AiTier)game.tier : TIER_NORMAL;
+}
+
+/**
+ * @brief Prints the "@<id> " prefix of replies in a session.
+ */
+void printSessionPrefix() {
+    if (activeSession != 0) {
+        Serial.print('@');
+        Serial.print(activeSession);
+        Serial.print(' ');
+    }
+}
+
+/**
+ * @brief "BLed": toggles the blue LED setting.
+ */
+void toggleBlueLed() {
+    BlueblinkLED();
+    blueLedState = !blueLedState; 
+    saveLedStateToEEPROM(); 
+}
+
+/**
+ * @brief "Yled": toggles the yellow LED setting.
+ */
+void toggleYellowLed() {
+    YellowblinkLED();
+    yellowLedState = !yellowLedState; 
+    saveLedStateToEEPROM(); 
+}
+
+/**
+ * @brief "bin": switches to binary frames and answers with HELLO.
+ */
+void enterBinaryMode() {
+    binaryMode = true;
+    frameReader.reset();
+    lastCommand = -1;
+    sendFrame(makeFrame(OP_HELLO, 0, PROTOCOL_VERSION));
+}
+
+/**
+ * @brief "reset": clears the board and sends it.
+ */
+void resetGame() {
+    DrawblinkLED();
+    resetBoard();
+}
+
+/// "player": starts a game with the human moving first.
+void startPlayerGame() {
+    if (!gameOver) startGame(MODE_PLAYER);
+}
+
+/// "ai": starts a game with the AI moving first.
+void startAIGame() {
+    if (!gameOver) startGame(MODE_AI);
+}
+
+/// "pvp": starts a two-player game.
+void startPvPGame() {
+    if (!gameOver) startGame(MODE_PVP);
+}
+
+/**
+ * @brief Sets the AI tier and answers "tier <name>".
+ * Applies from the next AI move on, also in a running game.
+ * @param tier The AiTier.
+ */
+void setAiTier(AiTier tier) {
+    aiTier = tier;
+    printSessionPrefix();
+    Serial.print(F("tier "));
+    Serial.println(reinterpret_cast<const __FlashStringHelper*>(tierName(tier)));
+}
+
+/// "normal": the original AI.
+void setNormalTier() { setAiTier(TIER_NORMAL); }
+
+/// "hard": the budgeted alpha-beta.
+void setHardTier() { setAiTier(TIER_HARD); }
+
+/// "easy": the budgeted Monte Carlo search.
+void setEasyTier() { setAiTier(TIER_EASY); }
+
+/**
+ * @brief "r,c": plays a move and sends the board and the result.
+ * Ignored when the game is over or the cell is taken.
+ * @param row Row index.
+ * @param col Column index.
+ */
+void handleMoveCommand(int row, int col) {
+    if (gameOver || !playMove(row, col)) {
         return;
     }
+    sendCurrentBoardState();
+    const char* result = statusText(finishMove());
+    if (result != 0) {
+        printSessionPrefix();
+        Serial.println(result);
+    }
+}
 
-    if (!gameOver) {
-        if (strcmp(receivedData, "player") == 0) {
-            sendCurrentBoardState();
-            waitingForPlayerMove = true; 
-            pvpmode = false;
-            memset(receivedData, 0, sizeof(receivedData));
-            return;
-        } else if (strcmp(receivedData, "ai") == 0) {
-            makeAIMove();
-            sendCurrentBoardState();
-            waitingForPlayerMove = true;
-            pvpmode = false;
-            memset(receivedData, 0, sizeof(receivedData));
-            return;
-        } else if (strcmp(receivedData, "pvp") == 0) {
-            pvpmode = true;
-            waitingForPlayerMove = false; 
-            playerTurn = true;
+/**
+ * @brief Handles a binary frame (see Protocol.h).
+ * Every command is answered with exactly one frame.
+ * @param frame The decoded frame.
+ */
+void processFrame(const Frame& frame) {
+    int16_t command = (frame.opcode << 3) | frame.seq;
+    if (command == lastCommand) {
+        Serial.write(lastReply, FRAME_SIZE);
+        return;
+    }
+    lastCommand = command;
+    replySeq = frame.seq;
+
+    switch (frame.opcode) {
+        case OP_HELLO:
+            sendFrame(makeFrame(OP_HELLO, replySeq, frame.payload[0] == 0 ? 0 : PROTOCOL_VERSION));
+            if (frame.payload[0] == 0) {
+                binaryMode = false;
+                dataIndex = 0;
+            }
+            break;
+        case OP_LED:
+            if (frame.payload[0] == 0) {
+                BlueblinkLED();
+                blueLedState = !blueLedState;
+            } else {
+                YellowblinkLED();
+                yellowLedState = !yellowLedState;
+            }
+            saveLedStateToEEPROM();
             sendCurrentBoardState();
-            memset(receivedData, 0, sizeof(receivedData));
-            return;
+            break;
+        case OP_RESET:
+            DrawblinkLED();
+            resetBoard();
+            break;
+        case OP_MODE:
+            if (gameOver || frame.payload[0] > MODE_PVP || frame.payload[1] >= AI_TIER_COUNT) {
+                sendFrame(makeFrame(OP_NACK, replySeq, gameOver ? NACK_MOVE : NACK_OPCODE));
+            } else {
+                aiTier = (AiTier)frame.payload[1];
+                startGame((GameMode)frame.payload[0]);
+            }
+            break;
+        case OP_MOVE:
+            if (frame.payload[0] > 8) {
+                sendFrame(makeFrame(OP_NACK, replySeq, NACK_OPCODE));
+            } else if (gameOver || !playMove(frame.payload[0] / 3, frame.payload[0] % 3)) {
+                sendFrame(makeFrame(OP_NACK, replySeq, NACK_MOVE));
+            } else {
+                GameStatus status = finishMove();
+                sendFrame(makeFrame(OP_DELTA, replySeq, lastDelta[0], lastDelta[1], status));
+            }
+            break;
+        default:
+            sendFrame(makeFrame(OP_NACK, replySeq, NACK_OPCODE));
+            break;
+    }
+}
+
+/**
+ * @brief Prints one timing as min/avg/max microseconds.
+ * @param name Field name, in flash.
+ * @param stat The timing.
+ */
+void printTiming(const __FlashStringHelper* name, const TimingStat& stat) {
+    Serial.print(' ');
+    Serial.print(name);
+    Serial.print('=');
+    Serial.print(stat.min);
+    Serial.print('/');
+    Serial.print(stat.average());
+    Serial.print('/');
+    Serial.print(stat.max);
+}
+
+/**
+ * @brief Answers the "stats" command with one line of counters:
+ * "stats cmds=N cmd_us=min/avg/max ai_us=min/avg/max rx_full=N parse_err=N frame_err=N
+ * sessions=N/N evicted=N baud=N link_err=N fallbacks=N free_ram=N".
+ */
+void sendStats() {
+    Serial.print(F("stats cmds="));
+    Serial.print((unsigned long)telemetry.command.count);
+    printTiming(F("cmd_us"), telemetry.command);
+    printTiming(F("ai_us"), telemetry.search);
+    Serial.print(F(" rx_full="));
+    Serial.print((unsigned long)telemetry.rxFull);
+    Serial.print(F(" parse_err="));
+    Serial.print((unsigned long)telemetry.parseErrors);
+    Serial.print(F(" frame_err="));
+    Serial.print((unsigned int)frameReader.errors);
+    Serial.print(F(" sessions="));
+    Serial.print(sessions.active());
+    Serial.print('/');
+    Serial.print(sessions.capacity());
+    Serial.print(F(" evicted="));
+    Serial.print(sessions.evictions);
+    Serial.print(F(" baud="));
+    Serial.print(linkSpeed.baud());
+    Serial.print(F(" link_err="));
+    Serial.print(linkErrors);
+    Serial.print(F(" fallbacks="));
+    Serial.print(linkSpeed.fallbacks);
+    Serial.print(F(" free_ram="));
+    Serial.println(freeRam());
+}
+
+/**
+ * @brief Answers the "results" command with the board's own game results:
+ * "results player=W/D/L ai=W/D/L pvp=W/D/L seq=N slot=N", wins and losses
+ * being the player's (X's in PvP), and where the newest record is.
+ */
+void sendResults() {
+    for (uint8_t mode = 0; mode < RESULT_MODES; mode++) {
+        Serial.print(mode == MODE_PLAYER ? F("results player=") : mode == MODE_AI ? F(" ai=") : F(" pvp="));
+        Serial.print(recordStore.result(mode, RESULT_WIN));
+        Serial.print('/');
+        Serial.print(recordStore.result(mode, RESULT_DRAW));
+        Serial.print('/');
+        Serial.print(recordStore.result(mode, RESULT_LOSS));
+    }
+    Serial.print(F(" seq="));
+    Serial.print(recordStore.sequence());
+    Serial.print(F(" slot="));
+    Serial.println(recordStore.newestSlot());
+}
+
+/**
+ * @brief Measures the free RAM between the heap and the stack.
+ * @return Free bytes, or -1 when not running on an AVR.
+ */
+int freeRam() {
+#ifdef __AVR__
+    extern int __heap_start, *__brkval;
+    int top;
+    return (int)&top - (__brkval == 0 ? (int)&__heap_start : (int)__brkval);
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief Sends a binary frame and keeps it for retransmitted commands.
+ * @param frame The frame to send.
+ */
+void sendFrame(const Frame& frame) {
+    encodeFrame(frame, lastReply);
+    Serial.write(lastReply, FRAME_SIZE);
+}
+
+/**
+ * @brief Starts a game in the given mode and sends the board.
+ * @param mode MODE_PLAYER, MODE_AI (the AI moves first) or MODE_PVP.
+ */
+void startGame(GameMode mode) {
+    gameMode = mode;
+    if (mode == MODE_AI) {
+        makeAIMove();
+    }
+    pvpmode = mode == MODE_PVP;
+    waitingForPlayerMove = !pvpmode;
+    if (pvpmode) {
+        playerTurn = true;
+    }
+    sendCurrentBoardState();
+}
+
+/**
+ * @brief Places a human move and, against the AI, the AI's reply.
+ * The moves placed are kept in lastDelta.
+ * @param row Row index.
+ * @param col Column index.
+ * @return False if the cell is taken.
+ */
+bool playMove(int row, int col) {
+    if (board[row][col] != ' ') {
+        return false;
+    }
+    lastDelta[1] = NO_DELTA;
+    if (pvpmode) {
+        board[row][col] = playerTurn ? 'X' : 'O';
+        playerTurn = !playerTurn; 
+    } else {
+        board[row][col] = 'X'; 
+        Pair reply = makeAIMove();
+        if (reply.first >= 0) {
+            lastDelta[1] = packDelta(ai, reply.first * 3 + reply.second);
         }
-        if (receivedData[1] == ',' && receivedData[0] >= '0' &&
-            receivedData[0] <= '2' && receivedData[2] >= '0' &&
-            receivedData[2] <= '2') {
-            
-            int row = receivedData[0] - '0';
-            int col = receivedData[2] - '0';
-
-            if (board[row][col] == ' ') { 
-                if (pvpmode) {
-                    board[row][col] = playerTurn ? 'X' : 'O';
-                    playerTurn = !playerTurn; 
-                } else {
-                    board[row][col] = 'X'; 
-                    makeAIMove();
-                    
-                }
-                moveCount++;
-                sendCurrentBoardState();
-                if (checkWinner()) {
-                    gameOver = true;
-                    if (pvpmode) {
-                        if (playerTurn) {
-                            YellowblinkLED(); 
-                            Serial.println("O win!");
-                        } else {
-                            BlueblinkLED(); 
-                            Serial.println("X win!");
-                        }
-                    } else {
-                        if (isAIMoveWinning()) { 
-                            YellowblinkLED();
-                            Serial.println("AI win!");
-                        } else {
-                            BlueblinkLED(); 
-                            Serial.println("You win!");
-                        }
-                    }
-                } else if (moveCount >= 9) {
-                    gameOver = true;
-                    DrawblinkLED(); 
-                    Serial.println("Draw!");
-                }
+    }
+    lastDelta[0] = packDelta(board[row][col], row * 3 + col);
+    moveCount++;
+    return true;
+}
+
+/**
+ * @brief Checks the board after a move, ends the game and blinks the LEDs.
+ * @return The game status, also kept in lastStatus.
+ */
+GameStatus finishMove() {
+    GameStatus status = STATUS_PLAYING;
+    if (checkWinner()) {
+        gameOver = true;
+        if (pvpmode) {
+            if (playerTurn) {
+                YellowblinkLED(); 
+                status = STATUS_O_WIN;
+            } else {
+                BlueblinkLED(); 
+                status = STATUS_X_WIN;
+            }
+        } else {
+            if (isAIMoveWinning()) { 
+                YellowblinkLED();
+                status = STATUS_AI_WIN;
+            } else {
+                BlueblinkLED(); 
+                status = STATUS_PLAYER_WIN;
             }
         }
-        memset(receivedData, 0, sizeof(receivedData));
-        dataIndex = 0;
+    } else if (moveCount >= 9) {
+        gameOver = true;
+        DrawblinkLED(); 
+        status = STATUS_DRAW;
     }
+    lastStatus = status;
+    if (status != STATUS_PLAYING) {
+        recordResult(status);
+    }
+    return status;
+}
+
+/**
+ * @brief Counts a finished game in the record store, by mode.
+ * @param status Final status; wins and losses are the player's (X's in PvP).
+ */
+void recordResult(GameStatus status) {
+    ResultKind kind = RESULT_LOSS;
+    if (status == STATUS_DRAW) kind = RESULT_DRAW;
+    else if (status == STATUS_PLAYER_WIN || status == STATUS_X_WIN) kind = RESULT_WIN;
+    recordStore.addResult(gameMode, kind, millis());
 }
 
 /**
  * @brief Saves the LED states to EEPROM.
+ * Only the record store's RAM copy changes here; loop() commits it.
  */
 void saveLedStateToEEPROM() {
-    if (EEPROM.read(0) != blueLedState) {
-        EEPROM.write(0, blueLedState);
-        
-    }
-    if (EEPROM.read(1) != yellowLedState) {
-        EEPROM.write(1, yellowLedState);
-        
-    }
+    recordStore.setLeds((blueLedState ? 1 : 0) | (yellowLedState ? 2 : 0), millis());
 }
 
 /**
- * @brief Loads the LED states from EEPROM.
+ * @brief Loads the LED states and the game results from EEPROM.
+ * Boards without a record yet kept the LEDs in bytes 0 and 1; those
+ * states are taken over and go into the first record.
  */
 void loadLedStateFromEEPROM() {
-    int blueState = EEPROM.read(0);
-    int yellowState = EEPROM.read(1);
-
-    blueLedState = (blueState == 1);
-    yellowLedState = (yellowState == 1);
+    if (recordStore.recover()) {
+        blueLedState = (recordStore.leds() & 1) != 0;
+        yellowLedState = (recordStore.leds() & 2) != 0;
+    } else {
+        blueLedState = EEPROM.read(0) == 1;
+        yellowLedState = EEPROM.read(1) == 1;
+        saveLedStateToEEPROM();
+    }
 
     digitalWrite(BlueledPin, blueLedState ? HIGH : LOW);
     digitalWrite(YellowledPin, yellowLedState ? HIGH : LOW);
@@ -224,12 +754,15 @@ bool isAIMoveWinning() {
 }
 
 /**
- * @brief Executes the AI's move.
- * Finds the best move for the AI using the minimax algorithm.
- * @return The best move as a Pair (row, column).
+ * @brief Executes the AI's move, chosen by chooseAiMove().
+ * @return The best move as a Pair (row, column), or {-1, -1} if the board is full.
  */
 Pair makeAIMove() {
-    Pair bestMove = findBestMove(board); 
+    unsigned long started = micros();
+    int8_t cell = chooseAiMove(toBitBoard(board), aiTier);
+    telemetry.search.add(micros() - started);
+    Pair bestMove = cellToPair(cell);
+    if (cell < 0) return bestMove;
     board[bestMove.first][bestMove.second] = 'O';
     moveCount++; 
     return bestMove;
@@ -248,16 +781,26 @@ void resetBoard() {
     gameOver = false;
     waitingForPlayerMove = false;
     pvpmode = false;
+    gameMode = MODE_PLAYER;
     playerTurn = true;
     isPlayerOneTurn = true; 
+    lastStatus = STATUS_PLAYING;
     memset(receivedData, 0, sizeof(receivedData));
     sendCurrentBoardState();
 }
 
 /**
  * @brief Sends the current state of the game board via serial.
+ * In binary mode the board goes out as a BOARD frame with the last status.
  */
 void sendCurrentBoardState() {
+    if (binaryMode) {
+        uint8_t payload[3];
+        packBoard(&board[0][0], lastStatus, payload);
+        sendFrame(makeFrame(OP_BOARD, replySeq, payload[0], payload[1], payload[2]));
+        return;
+    }
+    printSessionPrefix();
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
             Serial.print(board[i][j]); 
@@ -271,59 +814,62 @@ void sendCurrentBoardState() {
  * @return True if there is a winner, false otherwise.
  */
 bool checkWinner() {
-    for (int i = 0; i < 3; i++) {
-        if (board[i][0] == board[i][1] && board[i][1] == board[i][2] && board[i][0] != ' ') return true;
-        if (board[0][i] == board[1][i] && board[1][i] == board[2][i] && board[0][i] != ' ') return true;
-    }
-    if (board[0][0] == board[1][1] && board[1][1] == board[2][2] && board[0][0] != ' ') return true;
-    if (board[0][2] == board[1][1] && board[1][1] == board[2][0] && board[0][2] != ' ') return true;
-    return false;
+    return bbEvaluate(toBitBoard(board)) != 0;
 }
 
 /**
- * @brief Blinks the blue LED.
+ * @brief Blinks the blue LED without blocking (see Effects.h).
  */
 void BlueblinkLED() {
     if (blueLedState) { 
-        digitalWrite(BlueledPin, HIGH);
-        delay(300);
-        digitalWrite(BlueledPin, LOW);
+        effects.pulse(BlueledPin, BLINK_MS, millis());
     }
 }
 
 /**
- * @brief Blinks the yellow LED.
+ * @brief Blinks the yellow LED without blocking (see Effects.h).
  */
 void YellowblinkLED() {
     if (yellowLedState) { 
-        digitalWrite(YellowledPin, HIGH);
-        delay(300);
-        digitalWrite(YellowledPin, LOW);
+        effects.pulse(YellowledPin, BLINK_MS, millis());
     }
 }
 
 /**
- * @brief Blinks both LEDs in case of a draw.
+ * @brief Blinks the enabled LEDs together in case of a draw.
  */
 void DrawblinkLED() {
-    if (!blueLedState && !yellowLedState) return;
-    if (blueLedState && yellowLedState){
-      digitalWrite(BlueledPin, HIGH);
-      digitalWrite(YellowledPin, HIGH);
-      delay(300);
-      digitalWrite(BlueledPin, LOW);
-      digitalWrite(YellowledPin, LOW);
-    } else if (blueLedState && !yellowLedState) { 
-        digitalWrite(BlueledPin, HIGH);
-        delay(300);
-        digitalWrite(BlueledPin, LOW);
-    } else if (yellowLedState && !blueLedState){
-        digitalWrite(YellowledPin, HIGH);
-        delay(300);
-        digitalWrite(YellowledPin, LOW);
+    BlueblinkLED();
+    YellowblinkLED();
+}
+
+
+/**
+ * @brief Packs a char board into the bitboard used by the AI.
+ * @param board The game board.
+ * @return The same position as two 9-bit masks.
+ */
+BitBoard toBitBoard(char board[3][3]) {
+    BitBoard b = {0, 0};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            uint16_t bit = (uint16_t)1 << (i * 3 + j);
+            if (board[i][j] == ai) b.ai |= bit;
+            else if (board[i][j] != ' ') b.player |= bit;
+        }
     }
+    return b;
 }
 
+/**
+ * @brief Converts a bitboard cell index into board coordinates.
+ * @param cell Cell index 0..8, or -1.
+ * @return The move as a Pair (row, column), or {-1, -1} for -1.
+ */
+Pair cellToPair(int8_t cell) {
+    if (cell < 0) return {-1, -1};
+    return {cell / 3, cell % 3};
+}
 
 /**
  * @brief Evaluates the current board state.
@@ -331,18 +877,7 @@ void DrawblinkLED() {
  * @return 1 if AI wins, -1 if player wins, 0 otherwise.
  */
 int evaluate(char board[3][3]) {
-    for (int i = 0; i < 3; i++) {
-        if (board[i][0] != ' ' && board[i][0] == board[i][1] && board[i][1] == board[i][2])
-            return (board[i][0] == ai) ? 1 : -1;
-        if (board[0][i] != ' ' && board[0][i] == board[1][i] && board[1][i] == board[2][i])
-            return (board[0][i] == ai) ? 1 : -1;
-    }
-    if (board[0][0] != ' ' && board[0][0] == board[1][1] && board[1][1] == board[2][2])
-        return (board[0][0] == ai) ? 1 : -1;
-    if (board[0][2] != ' ' && board[0][2] == board[1][1] && board[1][1] == board[2][0])
-        return (board[0][2] == ai) ? 1 : -1;
-
-    return 0; 
+    return bbEvaluate(toBitBoard(board));
 }
 
 /**
@@ -351,10 +886,7 @@ int evaluate(char board[3][3]) {
  * @return True if there are empty cells, false otherwise.
  */
 bool isMovesLeft(char board[3][3]) {
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            if (board[i][j] == ' ') return false;
-    return true;
+    return bbIsMovesLeft(toBitBoard(board));
 }
 
 /**
@@ -364,20 +896,7 @@ bool isMovesLeft(char board[3][3]) {
  * @return True if a fork is possible, false otherwise.
  */
 bool canCreateFork(char board[3][3], char playerSymbol) {
-    int winningMoves = 0;
-
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == ' ') {
-                board[i][j] = playerSymbol;
-                if (evaluate(board) == ((playerSymbol == ai) ? 1 : -1)) {
-                    winningMoves++;
-                }
-                board[i][j] = ' ';
-            }
-        }
-    }
-    return winningMoves >= 2;
+    return bbCanCreateFork(toBitBoard(board), playerSymbol == ai);
 }
 
 /**
@@ -390,41 +909,7 @@ bool canCreateFork(char board[3][3], char playerSymbol) {
  * @return The evaluated score of the board.
  */
 int minimax(char board[3][3], int depth, bool isMaximizing, int alpha, int beta) {
-    if (depth > 9) return 0; 
-    int score = evaluate(board);
-
-    if (score == 1 || score == -1) return score; 
-    if (!isMovesLeft(board)) return 0; 
-
-    if (isMaximizing) {
-        int best = -1000;
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (board[i][j] == ' ') {
-                    board[i][j] = ai; 
-                    best = max(best, minimax(board, depth + 1, false, alpha, beta));
-                    board[i][j] = ' '; 
-                    alpha = max(alpha, best);
-                    if (beta <= alpha) break; 
-                }
-            }
-        }
-        return best;
-    } else {
-        int best = 1000;
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (board[i][j] == ' ') {
-                    board[i][j] = player; 
-                    best = min(best, minimax(board, depth + 1, true, alpha, beta));
-                    board[i][j] = ' '; 
-                    beta = min(beta, best);
-                    if (beta <= alpha) break; 
-                }
-            }
-        }
-        return best;
-    }
+    return bbMinimax(toBitBoard(board), depth, isMaximizing, alpha, beta);
 }
 
 /**
@@ -433,42 +918,7 @@ int minimax(char board[3][3], int depth, bool isMaximizing, int alpha, int beta)
  * @return The best move as a Pair (row, column).
  */
 Pair findBestMove(char board[3][3]) {
-    Pair bestMove = {-1, -1};
-    int bestVal = -1000;
-    int positionPriority[3][3] = {
-        {3, 2, 3},
-        {2, 4, 2},
-        {3, 2, 3}
-    };
-    Pair winningMove = findWinningMove(board, ai);
-    if (winningMove.first != -1) {
-        return winningMove; 
-    }
-    Pair blockingMove = findBlockingMove(board, player);
-    if (blockingMove.first != -1) {
-        return blockingMove;
-    }
-    Pair forkMove = findForkMove(board, ai);
-    if (forkMove.first != -1) {
-        return forkMove;
-    }
-
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (board[i][j] == ' ') { 
-                board[i][j] = ai; 
-                int moveVal = minimax(board, 0, false, -1000, 1000);
-                board[i][j] = ' '; 
-                moveVal += positionPriority[i][j];
-
-                if (moveVal > bestVal) {
-                    bestMove = {i, j};
-                    bestVal = moveVal;
-                }
-            }
-        }
-    }
-    return bestMove;
+    return cellToPair(bbFindBestMove(toBitBoard(board)));
 }
 
 /**
@@ -478,19 +928,7 @@ Pair findBestMove(char board[3][3]) {
  * @return The winning move as a Pair (row, column), or {-1, -1} if none found.
  */
 Pair findWinningMove(char board[3][3], char playerSymbol) {
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == ' ') { 
-                board[i][j] = playerSymbol; 
-                if (evaluate(board) == 1) { 
-                    board[i][j] = ' '; 
-                    return {i, j};
-                }
-                board[i][j] = ' '; 
-            }
-        }
-    }
-    return {-1, -1}; 
+    return cellToPair(firstCell(bbCellsScoring(toBitBoard(board), playerSymbol == ai, 1)));
 }
 
 /**
@@ -500,19 +938,7 @@ Pair findWinningMove(char board[3][3], char playerSymbol) {
  * @return The blocking move as a Pair (row, column), or {-1, -1} if none found.
  */
 Pair findBlockingMove(char board[3][3], char opponent) {
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == ' ') {
-                board[i][j] = opponent; 
-                if (evaluate(board) == -1) { 
-                    board[i][j] = ' '; 
-                    return {i, j}; 
-                }
-                board[i][j] = ' ';
-            }
-        }
-    }
-    return {-1, -1};
+    return cellToPair(firstCell(bbCellsScoring(toBitBoard(board), opponent == ai, -1)));
 }
 
 /**
@@ -522,17 +948,5 @@ Pair findBlockingMove(char board[3][3], char opponent) {
  * @return The fork move as a Pair (row, column), or {-1, -1} if none found.
  */
 Pair findForkMove(char board[3][3], char playerSymbol) {
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == ' ') { 
-                board[i][j] = playerSymbol; 
-                if (canCreateFork(board, playerSymbol)) {
-                    board[i][j] = ' '; 
-                    return {i, j}; 
-                }
-                board[i][j] = ' '; 
-            }
-        }
-    }
-    return {-1, -1};
+    return cellToPair(bbFindForkMove(toBitBoard(board), playerSymbol == ai));
 }
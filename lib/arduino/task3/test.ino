@@ -1,5 +1,7 @@
+#ifdef TASK3_UNIT_TESTS
 #include <AUnit.h>
 #include <EEPROM.h>
+#include "BoardSearch.h"
 
 test(EvaluateFunctionTest) {
     char testBoard1[3][3] = {
@@ -79,6 +81,63 @@ test(AIMoveTest) {
     assertEqual(board[1][1], 'O'); 
 }
 
+test(MoveTableMatchesSearchTest) {
+    for (uint16_t code = 0; code < 19683; code++) {
+        BitBoard b = {0, 0};
+        uint16_t rest = code;
+        for (uint8_t cell = 0; cell < 9; cell++, rest /= 3) {
+            if (rest % 3 == 1) b.ai |= (uint16_t)1 << cell;
+            if (rest % 3 == 2) b.player |= (uint16_t)1 << cell;
+        }
+        if (positionIndex(b) < 0) continue;
+        assertEqual((int) lookupBestMove(b), (int) bbFindBestMove(b));
+    }
+}
+
+test(CanonicalKeyTest) {
+    BitBoard corner = {0x001, 0x010}; // AI top-left, player centre
+    uint32_t key = canonicalKey(corner, true);
+    for (uint8_t s = 0; s < SYMMETRY_COUNT; s++) {
+        BitBoard image = {transformMask(corner.ai, s), transformMask(corner.player, s)};
+        assertEqual(canonicalKey(image, true), key);
+    }
+    BitBoard edge = {0x002, 0x010}; // AI top edge, player centre
+    assertTrue(canonicalKey(edge, true) != key);
+    assertTrue(canonicalKey(corner, false) != key);
+}
+
+test(TranspositionTableTest) {
+    Board<3, 3> board;
+    board.load("O   X    ", MARK_X);
+    BoardSearch<3, 3> search;
+    ttEnabled = false;
+    SearchResult plain = search.findBestMove(board, DEFAULT_SEARCH);
+    ttEnabled = true;
+    search.clearHistory();
+    SearchResult cached = search.findBestMove(board, DEFAULT_SEARCH);
+    assertEqual(cached.move, plain.move);
+    assertEqual(cached.value, plain.value);
+    assertTrue(cached.nodes < plain.nodes);
+}
+
+test(BoardMatchesBitBoardTest) {
+    Board<3, 3> general;
+    BoardSearch<3, 3> search;
+    char cells[9];
+    for (uint16_t code = 0; code < 19683; code++) {
+        BitBoard b = {0, 0};
+        uint16_t rest = code;
+        for (uint8_t cell = 0; cell < 9; cell++, rest /= 3) {
+            cells[cell] = " OX"[rest % 3];
+            if (rest % 3 == 1) b.ai |= (uint16_t)1 << cell;
+            if (rest % 3 == 2) b.player |= (uint16_t)1 << cell;
+        }
+        if (positionIndex(b) < 0 || bbEvaluate(b) != 0) continue;
+        general.load(cells, MARK_O);
+        assertEqual((int) search.findBestMove(general, LEGACY_SEARCH).move, (int) bbFindBestMove(b));
+    }
+}
+
 test(ProcessCommandTest) {
     strcpy(receivedData, "reset");
     processCommand();
@@ -89,7 +148,291 @@ test(ProcessCommandTest) {
     }
     strcpy(receivedData, "BLed");
     processCommand();
-    assertTrue(blueLedState); 
+    assertTrue(blueLedState);
+}
+
+test(ProtocolCodecTest) {
+    uint8_t bytes[FRAME_SIZE];
+    Frame frame;
+    encodeFrame(makeFrame(OP_MOVE, 5, 4), bytes);
+    assertTrue(decodeFrame(bytes, frame));
+    assertEqual(frame.opcode, OP_MOVE);
+    assertEqual(frame.seq, 5);
+    assertEqual(frame.payload[0], 4);
+    bytes[1] ^= 0x10;
+    assertFalse(decodeFrame(bytes, frame));
+
+    FrameReader reader;
+    encodeFrame(makeFrame(OP_RESET, 2), bytes);
+    assertFalse(reader.push(0x00, frame)); // noise before the frame
+    bool complete = false;
+    for (uint8_t i = 0; i < FRAME_SIZE; i++) complete = reader.push(bytes[i], frame);
+    assertTrue(complete);
+    assertEqual(frame.opcode, OP_RESET);
+
+    const char cells[9] = {'X', ' ', 'O', ' ', 'X', ' ', 'O', ' ', 'X'};
+    char unpacked[9];
+    uint8_t payload[3];
+    packBoard(cells, STATUS_PLAYER_WIN, payload);
+    assertEqual(unpackBoard(payload, unpacked), STATUS_PLAYER_WIN);
+    assertEqual(memcmp(cells, unpacked, 9), 0);
+}
+
+test(BinaryMoveTest) {
+    strcpy(receivedData, "bin");
+    processCommand();
+    assertTrue(binaryMode);
+    processFrame(makeFrame(OP_RESET, 0));
+    processFrame(makeFrame(OP_MODE, 1, MODE_PLAYER));
+    processFrame(makeFrame(OP_MOVE, 2, 0));
+    assertEqual(board[0][0], 'X');
+    assertEqual(board[1][1], 'O');
+    assertEqual(lastDelta[0], packDelta('X', 0));
+    assertEqual(lastDelta[1], packDelta('O', 4));
+    processFrame(makeFrame(OP_MOVE, 2, 0)); // retransmission is not applied twice
+    assertEqual(moveCount, 2);
+    processFrame(makeFrame(OP_HELLO, 3, 0));
+    assertFalse(binaryMode);
+    resetBoard();
+}
+
+test(EffectSchedulerTest) {
+    EffectScheduler<2> scheduler;
+    assertTrue(scheduler.pulse(BlueledPin, 300, 1000));
+    assertEqual(digitalRead(BlueledPin), HIGH);
+    assertEqual(scheduler.service(1299), 0);
+    assertEqual(scheduler.service(1300), 1);
+    assertEqual(digitalRead(BlueledPin), LOW);
+
+    unsigned long nearOverflow = (unsigned long)-100;
+    assertTrue(scheduler.pulse(YellowledPin, 300, nearOverflow));
+    assertTrue(scheduler.pulse(YellowledPin, 300, nearOverflow)); // restarted, not stacked
+    assertEqual(scheduler.pending(), 1);
+    assertEqual(scheduler.service(nearOverflow + 50), 0);
+    assertEqual(scheduler.service(nearOverflow + 300), 1);
+    assertEqual(digitalRead(YellowledPin), LOW);
+
+    scheduler.schedule(2, HIGH, 10, 0);
+    scheduler.schedule(3, HIGH, 10, 0);
+    assertFalse(scheduler.pulse(4, 300, 0));
+}
+
+test(StatsCommandTest) {
+    TimingStat stat = {0, 0, 0, 0};
+    stat.add(30);
+    stat.add(10);
+    stat.add(20);
+    assertEqual(stat.min, 10UL);
+    assertEqual(stat.max, 30UL);
+    assertEqual(stat.average(), 20UL);
+
+    resetBoard();
+    uint32_t searches = telemetry.search.count;
+    strcpy(receivedData, "player");
+    processCommand();
+    strcpy(receivedData, "0,0");
+    processCommand();
+    assertEqual(telemetry.search.count, searches + 1);
+    assertTrue(telemetry.search.max >= telemetry.search.min);
+    strcpy(receivedData, "stats");
+    processCommand();
+    assertEqual(board[0][0], 'X');
+    resetBoard();
+}
+
+test(CommandBurstTest) {
+    assertTrue(commandTable.find("pvp") == startPvPGame);
+    assertTrue(commandTable.find("hard") == setHardTier);
+    assertTrue(commandTable.find("pv") == 0);
+    assertTrue(commandTable.find("") == 0);
+
+    resetBoard();
+    bool blue = blueLedState;
+    uint32_t errors = telemetry.parseErrors;
+    const char* burst = "player\n0,0\nBLed\nthis line does not fit\n";
+    for (const char* c = burst; *c != '\0'; c++) rxRing.push((uint8_t)*c);
+    handleInput();
+    assertTrue(rxRing.empty());
+    assertEqual(board[0][0], 'X');
+    assertEqual(moveCount, 2);
+    assertTrue(blueLedState != blue);
+    assertEqual(telemetry.parseErrors, errors + 1);
+
+    const char* undo = "BLed\nreset\n";
+    for (const char* c = undo; *c != '\0'; c++) rxRing.push((uint8_t)*c);
+    handleInput();
+    assertEqual(blueLedState, blue);
+    assertEqual(moveCount, 0);
+}
+
+test(SessionTest) {
+    resetBoard();
+    sessions.clear();
+    strcpy(receivedData, "@7 pvp");
+    processCommand();
+    strcpy(receivedData, "@7 1,1");
+    processCommand();
+    strcpy(receivedData, "@12 0,0");
+    processCommand();
+    assertEqual(board[1][1], ' ');
+    assertEqual(moveCount, 0);
+    assertEqual(sessions.active(), 2);
+
+    strcpy(receivedData, "@7 0,0");
+    processCommand();
+    PackedGame pvp = sessions.acquire(7).game;
+    assertEqual(pvp.cell(4), 'X');
+    assertEqual(pvp.cell(0), 'O');
+    assertEqual((int)pvp.moves, 2);
+    assertEqual(sessions.acquire(12).game.cell(0), 'X');
+
+    uint32_t errors = telemetry.parseErrors;
+    strcpy(receivedData, "@0 reset");
+    processCommand();
+    strcpy(receivedData, "@7reset");
+    processCommand();
+    assertEqual(telemetry.parseErrors, errors + 2);
+
+    SessionPool<2> pool;
+    pool.acquire(1);
+    pool.acquire(2);
+    pool.acquire(1);
+    pool.acquire(3); // evicts 2, the least recently used
+    assertEqual(pool.evictions, 1);
+    assertEqual(pool.acquire(1).id, 1);
+    pool.acquire(2);
+    assertEqual(pool.evictions, 2);
+    sessions.clear();
+}
+
+/**
+ * @brief Lets the record store commit everything pending (at most 1 s).
+ */
+void flushRecordStore() {
+    unsigned long due = millis() + RecordStore::COMMIT_DELAY_MS;
+    unsigned long started = millis();
+    while (!recordStore.idle() && millis() - started < 1000) {
+        recordStore.service(due);
+    }
+}
+
+test(RecordStoreTest) {
+    assertEqual((int) sizeof(StoreRecord), 22);
+    bool blue = blueLedState;
+    strcpy(receivedData, "BLed");
+    processCommand();
+    flushRecordStore();
+    assertTrue(recordStore.idle());
+    uint16_t seq = recordStore.sequence();
+    uint16_t slot = recordStore.newestSlot();
+    uint16_t wins = recordStore.result(MODE_PVP, RESULT_WIN);
+    RecordStore boot;
+    assertTrue(boot.recover());
+    assertEqual(boot.sequence(), seq);
+    assertEqual(boot.leds() & 1, blueLedState ? 1 : 0);
+
+    // A won PvP game and a toggle make one record, written only when due.
+    resetBoard();
+    const char* const moves[] = { "pvp", "0,0", "1,0", "0,1", "1,1", "0,2", "BLed" };
+    for (uint8_t i = 0; i < 7; i++) {
+        strcpy(receivedData, moves[i]);
+        processCommand();
+    }
+    assertEqual(lastStatus, STATUS_X_WIN);
+    assertEqual(recordStore.result(MODE_PVP, RESULT_WIN), wins + 1);
+    recordStore.service(millis());
+    assertFalse(recordStore.idle());
+    assertEqual(recordStore.sequence(), seq);
+
+    // Cut short after a byte, the store still boots into the previous record.
+    recordStore.service(millis() + RecordStore::COMMIT_DELAY_MS);
+    assertTrue(boot.recover());
+    assertEqual(boot.sequence(), seq);
+    assertEqual(boot.result(MODE_PVP, RESULT_WIN), wins);
+
+    flushRecordStore();
+    assertTrue(boot.recover());
+    assertEqual(boot.sequence(), recordStore.sequence());
+    assertEqual(boot.newestSlot(), (uint16_t)((slot + 1) % RecordStore::SLOTS));
+    assertEqual(boot.result(MODE_PVP, RESULT_WIN), wins + 1);
+    assertEqual(blueLedState, blue);
+    resetBoard();
+}
+
+test(LinkSpeedTest) {
+    // The link logic alone: a test must not switch the rate it reports on.
+    assertTrue(strlen("sync ") + sizeof(LINK_PATTERN) - 1 < sizeof(receivedData));
+    LinkSpeed speed;
+    assertEqual(speed.baud(), LINK_DEFAULT_BAUD);
+    assertFalse(speed.startTrial(12345, 0));
+    assertEqual(speed.baud(), LINK_DEFAULT_BAUD);
+
+    // An unconfirmed trial falls back once LINK_TRIAL_MS has passed.
+    assertTrue(speed.startTrial(115200, 100));
+    assertTrue(speed.inTrial());
+    assertEqual(speed.service(100 + LINK_TRIAL_MS - 1, 0), (uint32_t)0);
+    assertEqual(speed.service(100 + LINK_TRIAL_MS, 0), LINK_DEFAULT_BAUD);
+    assertEqual(speed.fallbacks, 1);
+
+    // A confirmed rate stays until LINK_ERROR_LIMIT errors fall into one window.
+    assertTrue(speed.startTrial(1000000, 5000));
+    assertTrue(speed.confirm());
+    assertFalse(speed.confirm());
+    assertEqual(speed.service(5000 + 10 * LINK_TRIAL_MS, 1), (uint32_t)0);
+    assertEqual(speed.service(5000 + 20 * LINK_TRIAL_MS, 2), (uint32_t)0);
+    assertEqual(speed.baud(), (uint32_t)1000000);
+    assertEqual(speed.service(5000 + 20 * LINK_TRIAL_MS + 1, 2 + LINK_ERROR_LIMIT - 1), LINK_DEFAULT_BAUD);
+    assertEqual(speed.fallbacks, 2);
+    assertFalse(speed.inTrial());
+
+    // The default rate needs no confirmation and errors there change nothing.
+    assertTrue(speed.startTrial(LINK_DEFAULT_BAUD, 0));
+    assertFalse(speed.inTrial());
+    assertEqual(speed.service(0, 100), (uint32_t)0);
+}
+
+test(AiTierTest) {
+    // Budgets: a 1 us deadline still gives a legal move, playouts stop at
+    // maxNodes, and the tree never outgrows its pool.
+    Board<3, 3> position;
+    position.load("X   O    ", MARK_X);
+    // The engines of the tiers: test-local copies would take ~370 bytes of stack.
+    BoardSearch<3, 3>& search = tierAlphaBeta();
+    SearchResult rushed = search.findBestMove(position, SearchLimits{0, 0, 1});
+    assertTrue(rushed.move >= 0 && position.at(rushed.move) == MARK_NONE);
+    MctsSearch<3, 3, AI_MCTS_POOL>& mcts = tierMonteCarlo();
+    SearchResult first = mcts.findBestMove(position, SearchLimits{0, 40, 0});
+    assertEqual(first.nodes, (uint32_t)40);
+    assertTrue(mcts.nodesUsed() <= AI_MCTS_POOL);
+    assertEqual(mcts.findBestMove(position, SearchLimits{0, 40, 0}).move, first.move);
+    assertEqual(position.markCount(), 2);
+
+    // Every tier takes a win and repeats its reply; a budgeted tier that
+    // differs here hit its 10 ms deadline on this board.
+    BitBoard win = {0x003, 0x018}; // AI 0,1; player 3,4
+    BitBoard open = {0x000, 0x001}; // player in a corner
+    for (uint8_t tier = 0; tier < AI_TIER_COUNT; tier++) {
+        assertEqual((int)chooseAiMove(win, tier), 2);
+        assertEqual((int)chooseAiMove(open, tier), (int)chooseAiMove(open, tier));
+    }
+
+    // The tier commands set the tier, and a session keeps its own.
+    resetBoard();
+    sessions.clear();
+    strcpy(receivedData, "@3 easy");
+    processCommand();
+    strcpy(receivedData, "@4 pvp");
+    processCommand();
+    assertEqual((int)sessions.acquire(3).game.tier, (int)TIER_EASY);
+    assertEqual((int)sessions.acquire(4).game.tier, (int)TIER_NORMAL);
+    strcpy(receivedData, "hard");
+    processCommand();
+    assertEqual((int)aiTier, (int)TIER_HARD);
+    strcpy(receivedData, "normal");
+    processCommand();
+    assertEqual((int)aiTier, (int)TIER_NORMAL);
+    sessions.clear();
+    resetBoard();
 }
 
 test(MinimaxBlockTest) {
@@ -112,3 +455,4 @@ test(MinimaxDrawTest) {
     assertEqual(score, 0); 
 }
 
+#endif // TASK3_UNIT_TESTS
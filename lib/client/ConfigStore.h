@@ -0,0 +1,274 @@
+/**
+ * @file ConfigStore.h
+ * @brief In-memory config.ini with a write-behind journal.
+ *
+ * Reads and writes go to a map in memory. Every change is queued as one
+ * journal line "section<TAB>key<TAB>value" and a background thread appends
+ * the queued lines in batches to "<ini>.journal", flushing them to disk.
+ * Once the journal holds COMPACT_AFTER lines, and on close(), the thread
+ * writes the whole map into a temporary INI and renames it over the
+ * original, then empties the journal. open() replays a journal left by a
+ * crash; journal values are absolute, so replaying a line twice is harmless
+ * and a torn last line is ignored.
+ */
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "SimpleIni.h"
+#include "Log.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @class ConfigStore
+ * @brief Write-behind key/value store backed by an INI file and a journal.
+ */
+class ConfigStore {
+public:
+    /// Journal lines after which the INI is rewritten.
+    static const size_t COMPACT_AFTER = 64;
+
+    ConfigStore() : journal(NULL), journalLines(0), queued(0), saved(0), running(false) {}
+    ~ConfigStore() { close(); }
+
+    /**
+     * @brief Loads the INI, replays a leftover journal and starts the writer thread.
+     * @param iniPath Path of config.ini.
+     * @return False if the INI cannot be read (the store still works in memory).
+     */
+    bool open(const std::string& iniPath) {
+        close();
+        path = iniPath;
+        journalPath = iniPath + ".journal";
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        bool loaded = ini.LoadFile(path.c_str()) == SI_OK;
+        if (loaded) {
+            CSimpleIniA::TNamesDepend sections;
+            ini.GetAllSections(sections);
+            for (CSimpleIniA::TNamesDepend::const_iterator s = sections.begin(); s != sections.end(); ++s) {
+                CSimpleIniA::TNamesDepend keys;
+                ini.GetAllKeys(s->pItem, keys);
+                for (CSimpleIniA::TNamesDepend::const_iterator k = keys.begin(); k != keys.end(); ++k) {
+                    values[Key(s->pItem, k->pItem)] = ini.GetValue(s->pItem, k->pItem, "");
+                }
+            }
+        } else {
+            logMessage(LOG_ERROR, "Failed to load INI file.");
+        }
+        size_t replayed = replayJournal();
+        if (replayed > 0) {
+            logMessage(LOG_INFO, "Recovered %lu settings from %s", (unsigned long)replayed, journalPath.c_str());
+            compact();
+        }
+        if (journal == NULL) journal = std::fopen(journalPath.c_str(), "ab");
+        running = true;
+        writer = std::thread(&ConfigStore::run, this);
+        return loaded;
+    }
+
+    /**
+     * @brief Writes everything queued, compacts and stops the writer thread.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_all();
+        writer.join();
+        if (journal != NULL) {
+            std::fclose(journal);
+            journal = NULL;
+        }
+    }
+
+    /**
+     * @brief Blocks until every change queued so far is in the journal on disk.
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        uint64_t target = queued;
+        written.wait(lock, [this, target] { return saved >= target || !running; });
+    }
+
+    /// @return The value, or fallback if the key is missing.
+    std::string getString(const char* section, const char* key, const char* fallback) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<Key, std::string>::const_iterator it = values.find(Key(section, key));
+        return it == values.end() ? fallback : it->second;
+    }
+
+    /// @return The value as a number, or fallback if the key is missing.
+    long getLong(const char* section, const char* key, long fallback) const {
+        std::string value = getString(section, key, "");
+        return value.empty() ? fallback : std::strtol(value.c_str(), NULL, 10);
+    }
+
+    /// @return The value as a flag ("true"/"1"), or fallback if the key is missing.
+    bool getBool(const char* section, const char* key, bool fallback) const {
+        std::string value = getString(section, key, "");
+        if (value.empty()) return fallback;
+        return value == "true" || value == "1" || value == "yes" || value == "on";
+    }
+
+    /**
+     * @brief Changes a value in memory and queues it for the journal; returns at once.
+     */
+    void set(const char* section, const char* key, const std::string& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string& current = values[Key(section, key)];
+        if (current == value) return;
+        current = value;
+        pending.push_back(std::string(section) + '\t' + key + '\t' + value + '\n');
+        queued++;
+        wake.notify_one();
+    }
+
+    void setLong(const char* section, const char* key, long value) { set(section, key, std::to_string(value)); }
+    void setBool(const char* section, const char* key, bool value) { set(section, key, value ? "true" : "false"); }
+
+private:
+    typedef std::pair<std::string, std::string> Key;
+
+    /**
+     * @brief Writer thread: appends queued lines in batches, compacts when due.
+     */
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return !pending.empty() || !running; });
+            std::vector<std::string> batch;
+            batch.swap(pending);
+            uint64_t batchEnd = queued;
+            bool stopping = !running;
+            lock.unlock();
+
+            appendToJournal(batch);
+            bool compactNow = journalLines >= COMPACT_AFTER || (stopping && journalLines > 0);
+
+            lock.lock();
+            saved = batchEnd;
+            written.notify_all();
+            if (compactNow) {
+                std::map<Key, std::string> snapshot = values;
+                lock.unlock();
+                writeIni(snapshot);
+                lock.lock();
+            }
+            if (stopping && pending.empty()) return;
+        }
+    }
+
+    void appendToJournal(const std::vector<std::string>& batch) {
+        if (journal == NULL || batch.empty()) return;
+        for (size_t i = 0; i < batch.size(); i++) {
+            std::fputs(batch[i].c_str(), journal);
+        }
+        syncFile(journal);
+        journalLines += batch.size();
+    }
+
+    /**
+     * @brief Applies the complete lines of the journal to the map.
+     * @return Number of lines applied.
+     */
+    size_t replayJournal() {
+        std::ifstream in(journalPath.c_str(), std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t applied = 0, start = 0;
+        for (size_t end = content.find('\n'); end != std::string::npos; start = end + 1, end = content.find('\n', start)) {
+            std::string line = content.substr(start, end - start);
+            size_t first = line.find('\t');
+            size_t second = first == std::string::npos ? first : line.find('\t', first + 1);
+            if (second == std::string::npos) continue;
+            values[Key(line.substr(0, first), line.substr(first + 1, second - first - 1))] = line.substr(second + 1);
+            applied++;
+        }
+        return applied;
+    }
+
+    /// Rewrites the INI from the current map (writer thread or open() only).
+    void compact() {
+        writeIni(values);
+    }
+
+    /**
+     * @brief Writes the values into a temporary copy of the INI, renames it
+     * over the original and empties the journal.
+     */
+    void writeIni(const std::map<Key, std::string>& snapshot) {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        ini.LoadFile(path.c_str()); // keeps comments and order of the existing file
+        for (std::map<Key, std::string>::const_iterator it = snapshot.begin(); it != snapshot.end(); ++it) {
+            ini.SetValue(it->first.first.c_str(), it->first.second.c_str(), it->second.c_str());
+        }
+        std::string temporary = path + ".tmp";
+        FILE* out = std::fopen(temporary.c_str(), "wb");
+        if (out == NULL || ini.SaveFile(out, true) != SI_OK || !syncFile(out)) {
+            if (out != NULL) std::fclose(out);
+            logMessage(LOG_ERROR, "Failed to save INI file.");
+            return;
+        }
+        std::fclose(out);
+        if (!replaceFile(temporary, path)) {
+            logMessage(LOG_ERROR, "Failed to save INI file.");
+            return;
+        }
+        // The INI now holds every journal line; start an empty journal.
+        if (journal != NULL) std::fclose(journal);
+        journal = std::fopen(journalPath.c_str(), "wb");
+        journalLines = 0;
+    }
+
+    static bool syncFile(FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    static bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    std::string path;
+    std::string journalPath;
+    std::map<Key, std::string> values;  ///< Current settings (mutex).
+    std::vector<std::string> pending;   ///< Journal lines not written yet (mutex).
+    FILE* journal;                      ///< Writer thread only after open().
+    size_t journalLines;                ///< Writer thread only after open().
+    uint64_t queued;                    ///< Lines ever queued (mutex).
+    uint64_t saved;                     ///< Lines ever written to the journal (mutex).
+    bool running;                       ///< mutex.
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    std::thread writer;
+};
+
+#endif // CONFIG_STORE_H
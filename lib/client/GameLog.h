@@ -0,0 +1,274 @@
+/**
+ * @file GameLog.h
+ * @brief Append-only binary log of finished games.
+ *
+ * File layout: a 16-byte GameLogHeader, then fixed 32-byte GameRecord
+ * entries, little-endian, written as-is. A record holds the mode, the
+ * result, up to nine moves packed 4 bits each (first move in the low nibble
+ * of moves[0]), start time, duration, the summed round trip of the moves
+ * the client sent and a checksum. Because the size is fixed, a reader can
+ * map the file and index records directly. A record torn by a crash fails
+ * its checksum and is skipped; open() pads it to full size so the records
+ * appended after it stay aligned.
+ *
+ * The UI thread only fills a GameRecorder and queues the finished record;
+ * GameLog's thread does the file writes.
+ */
+#ifndef GAME_LOG_H
+#define GAME_LOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../arduino/task3/Protocol.h"
+
+/// Version of the log layout.
+const uint16_t GAME_LOG_VERSION = 1;
+
+/**
+ * @struct GameLogHeader
+ * @brief First 16 bytes of a log file.
+ */
+struct GameLogHeader {
+    char magic[4];        ///< "TTTL".
+    uint16_t version;     ///< GAME_LOG_VERSION.
+    uint16_t recordSize;  ///< sizeof(GameRecord).
+    uint8_t reserved[8];
+};
+
+/**
+ * @struct GameRecord
+ * @brief One finished game.
+ */
+struct GameRecord {
+    uint64_t startMs;       ///< Start of the game, ms since the Unix epoch.
+    uint32_t durationMs;    ///< Time from the first board to the result.
+    uint32_t latencyUs;     ///< Sum of the round trips of the moves sent by the client.
+    uint8_t mode;           ///< GameMode.
+    uint8_t result;         ///< GameStatus.
+    uint8_t moveCount;      ///< Moves played, 0..9.
+    uint8_t latencyCount;   ///< Moves included in latencyUs.
+    uint8_t moves[5];       ///< Cells in play order, 4 bits each.
+    uint8_t reserved[3];
+    uint32_t checksum;      ///< FNV-1a of the bytes before it.
+
+    /// @return Cell of the i-th move.
+    uint8_t move(uint8_t i) const { return (moves[i >> 1] >> ((i & 1) * 4)) & 0x0F; }
+
+    /// Appends a move; ignored once nine moves are stored.
+    void addMove(uint8_t cell) {
+        if (moveCount >= 9) return;
+        moves[moveCount >> 1] |= (uint8_t)((cell & 0x0F) << ((moveCount & 1) * 4));
+        moveCount++;
+    }
+
+    /// @return FNV-1a over every field but checksum.
+    uint32_t computeChecksum() const {
+        const uint8_t* bytes = (const uint8_t*)this;
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < offsetof(GameRecord, checksum); i++) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    /// @return True if the checksum matches.
+    bool valid() const { return checksum == computeChecksum() && moveCount <= 9; }
+};
+
+static_assert(sizeof(GameLogHeader) == 16, "GameLogHeader must stay 16 bytes");
+static_assert(sizeof(GameRecord) == 32, "GameRecord must stay 32 bytes");
+
+/**
+ * @class GameRecorder
+ * @brief Builds the record of the running game from the boards the client sees.
+ */
+class GameRecorder {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    GameRecorder() : active(false), pendingCell(-1) {}
+
+    /**
+     * @brief Starts a game on an empty board.
+     * @param mode GameMode of the game.
+     */
+    void begin(uint8_t mode) {
+        memset(&record, 0, sizeof(record));
+        record.mode = mode;
+        record.startMs = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        started = Clock::now();
+        memset(cells, ' ', sizeof(cells));
+        pendingCell = -1;
+        active = true;
+    }
+
+    /// @return True between begin() and finish().
+    bool running() const { return active; }
+
+    /**
+     * @brief Notes a move sent to the Arduino, to time its reply.
+     * @param cell Cell index.
+     */
+    void moveSent(uint8_t cell) {
+        pendingCell = cell;
+        sent = Clock::now();
+    }
+
+    /**
+     * @brief Takes a board from the Arduino and appends the new marks.
+     * The client's own move goes before the AI's reply placed in the same board.
+     * @param board Row-major cells.
+     */
+    void observe(const char* board) {
+        if (!active) return;
+        if (pendingCell >= 0 && cells[pendingCell] == ' ' && board[pendingCell] != ' ') {
+            record.addMove((uint8_t)pendingCell);
+            cells[pendingCell] = board[pendingCell];
+            record.latencyUs += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent).count();
+            record.latencyCount++;
+            pendingCell = -1;
+        }
+        for (uint8_t cell = 0; cell < 9; cell++) {
+            if (cells[cell] == ' ' && board[cell] != ' ') {
+                record.addMove(cell);
+                cells[cell] = board[cell];
+            }
+        }
+    }
+
+    /**
+     * @brief Ends the game.
+     * @param result Final GameStatus.
+     * @return The finished record.
+     */
+    GameRecord finish(uint8_t result) {
+        active = false;
+        record.result = result;
+        record.durationMs = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started).count();
+        record.checksum = record.computeChecksum();
+        return record;
+    }
+
+private:
+    GameRecord record;
+    bool active;
+    char cells[9];          ///< Board as recorded so far.
+    int pendingCell;        ///< Move waiting for its reply, -1 if none.
+    Clock::time_point started;
+    Clock::time_point sent;
+};
+
+/**
+ * @class GameLog
+ * @brief Appends records to the log file on a background thread.
+ */
+class GameLog {
+public:
+    GameLog() : file(NULL), running(false) {}
+    ~GameLog() { close(); }
+
+    /**
+     * @brief Opens (or creates) the log and starts the writer thread.
+     * @param path Log file.
+     * @return False if the file cannot be opened or has another layout.
+     */
+    bool open(const std::string& path) {
+        close();
+        file = std::fopen(path.c_str(), "ab");
+        if (file == NULL) return false;
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        if (size == 0) {
+            GameLogHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, "TTTL", 4);
+            header.version = GAME_LOG_VERSION;
+            header.recordSize = sizeof(GameRecord);
+            std::fwrite(&header, sizeof(header), 1, file);
+            std::fflush(file);
+        } else if (!checkHeader(path)) {
+            std::fclose(file);
+            file = NULL;
+            return false;
+        } else if ((size - (long)sizeof(GameLogHeader)) % sizeof(GameRecord) != 0) {
+            size_t torn = (size_t)(size - (long)sizeof(GameLogHeader)) % sizeof(GameRecord);
+            static const uint8_t zeros[sizeof(GameRecord)] = {};
+            std::fwrite(zeros, sizeof(GameRecord) - torn, 1, file);
+            std::fflush(file);
+        }
+        running = true;
+        writer = std::thread(&GameLog::run, this);
+        return true;
+    }
+
+    /**
+     * @brief Writes what is queued and stops the writer thread.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_all();
+        writer.join();
+        std::fclose(file);
+        file = NULL;
+    }
+
+    /**
+     * @brief Queues a record; returns at once.
+     */
+    void append(const GameRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        pending.push_back(record);
+        wake.notify_one();
+    }
+
+private:
+    static bool checkHeader(const std::string& path) {
+        FILE* in = std::fopen(path.c_str(), "rb");
+        if (in == NULL) return false;
+        GameLogHeader header;
+        bool ok = std::fread(&header, sizeof(header), 1, in) == 1 && memcmp(header.magic, "TTTL", 4) == 0
+            && header.version == GAME_LOG_VERSION && header.recordSize == sizeof(GameRecord);
+        std::fclose(in);
+        return ok;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return !pending.empty() || !running; });
+            std::vector<GameRecord> batch;
+            batch.swap(pending);
+            bool stopping = !running;
+            lock.unlock();
+            if (!batch.empty()) {
+                std::fwrite(&batch[0], sizeof(GameRecord), batch.size(), file);
+                std::fflush(file);
+            }
+            lock.lock();
+            if (stopping && pending.empty()) return;
+        }
+    }
+
+    FILE* file;                      ///< Writer thread only after open().
+    std::vector<GameRecord> pending; ///< mutex.
+    bool running;                    ///< mutex.
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread writer;
+};
+
+#endif // GAME_LOG_H
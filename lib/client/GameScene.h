@@ -0,0 +1,189 @@
+/**
+ * @file GameScene.h
+ * @brief Retained-mode renderer of the game window.
+ *
+ * Everything that does not change during a game (grid lines, button
+ * rectangles) is built once into a single vertex array, and button labels
+ * are kept as ready sf::Text objects. X and O are rendered once into small
+ * textures; the marks of the board become one textured vertex batch per
+ * glyph, rebuilt only when the board changes. A frame is drawn and presented
+ * only when something is dirty, so the cost of an idle frame is one memcmp
+ * and the cost of a frame does not grow with sf::Text objects per cell.
+ * An optional text overlay (the latency HUD) is drawn on top.
+ */
+#ifndef GAME_SCENE_H
+#define GAME_SCENE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @class GameScene
+ * @brief Cached scene of the board, the marks and the buttons.
+ */
+class GameScene {
+public:
+    /// Thickness of the grid lines in pixels.
+    static const int LINE_WIDTH = 5;
+    /// Character size of the X and O glyphs.
+    static const int MARK_SIZE = 100;
+    /// Character size of the overlay text.
+    static const int OVERLAY_SIZE = 12;
+
+    /**
+     * @brief Builds the grid and renders the glyph textures.
+     * @param font Font of the X and O glyphs.
+     * @param size Cells per side.
+     * @param tileSize Size of a cell in pixels.
+     */
+    GameScene(const sf::Font& font, int size, int tileSize)
+        : size(size), tileSize(tileSize), background(sf::Triangles), cells(size * size, ' '), dirty(true) {
+        for (int i = 0; i <= size; ++i) {
+            addRectangle(0, i * tileSize, tileSize * size, LINE_WIDTH, sf::Color::Black);
+            addRectangle(i * tileSize - 4, 0, LINE_WIDTH, tileSize * size, sf::Color::Black);
+        }
+        renderGlyph(font, 'X', glyphs[0]);
+        renderGlyph(font, 'O', glyphs[1]);
+        marks[0].setPrimitiveType(sf::Triangles);
+        marks[1].setPrimitiveType(sf::Triangles);
+        overlayText.setFont(font);
+        overlayText.setCharacterSize(OVERLAY_SIZE);
+        overlayText.setFillColor(sf::Color::White);
+        overlayText.setPosition(8, 6);
+        overlayPanel.setFillColor(sf::Color(0, 0, 0, 170));
+        overlayPanel.setPosition(4, 4);
+    }
+
+    /**
+     * @brief Adds a button; its rectangle joins the static batch.
+     * @param button Button shape.
+     * @param label Button label.
+     */
+    void addButton(const sf::RectangleShape& button, const sf::Text& label) {
+        sf::FloatRect bounds = button.getGlobalBounds();
+        addRectangle(bounds.left, bounds.top, bounds.width, bounds.height, button.getFillColor());
+        labels.push_back(label);
+        dirty = true;
+    }
+
+    /**
+     * @brief Takes the current board; rebuilds the mark batches if it changed.
+     * @param board size * size row-major cells (' ', 'X' or 'O').
+     */
+    void setBoard(const char* board) {
+        if (memcmp(&cells[0], board, cells.size()) == 0) {
+            return;
+        }
+        memcpy(&cells[0], board, cells.size());
+        marks[0].clear();
+        marks[1].clear();
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                char mark = cells[i * size + j];
+                if (mark == 'X' || mark == 'O') {
+                    addGlyph(marks[mark == 'X' ? 0 : 1], j * tileSize, i * tileSize);
+                }
+            }
+        }
+        dirty = true;
+    }
+
+    /**
+     * @brief Shows text in a translucent panel over the board, or hides it.
+     * @param text Lines to show; empty hides the overlay.
+     */
+    void setOverlay(const std::string& text) {
+        if (text == overlay) {
+            return;
+        }
+        overlay = text;
+        overlayText.setString(text);
+        sf::FloatRect bounds = overlayText.getLocalBounds();
+        overlayPanel.setSize(sf::Vector2f(bounds.width + 12, bounds.height + 12));
+        dirty = true;
+    }
+
+    /// Forces a redraw, e.g. after the window was resized or regained focus.
+    void invalidate() { dirty = true; }
+
+    /**
+     * @brief Draws and presents the frame if anything changed.
+     * @param window Target window.
+     * @return True if a frame was presented.
+     */
+    bool present(sf::RenderWindow& window) {
+        if (!dirty) {
+            return false;
+        }
+        window.clear(sf::Color::White);
+        window.draw(background);
+        for (int g = 0; g < 2; ++g) {
+            sf::RenderStates states;
+            states.texture = &glyphs[g].getTexture();
+            window.draw(marks[g], states);
+        }
+        for (size_t i = 0; i < labels.size(); ++i) {
+            window.draw(labels[i]);
+        }
+        if (!overlay.empty()) {
+            window.draw(overlayPanel);
+            window.draw(overlayText);
+        }
+        window.display();
+        dirty = false;
+        return true;
+    }
+
+private:
+    void addRectangle(float x, float y, float width, float height, sf::Color color) {
+        sf::Vector2f corners[4] = { {x, y}, {x + width, y}, {x + width, y + height}, {x, y + height} };
+        static const int ORDER[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int k = 0; k < 6; ++k) {
+            background.append(sf::Vertex(corners[ORDER[k]], color));
+        }
+    }
+
+    void addGlyph(sf::VertexArray& batch, float x, float y) {
+        float t = (float)tileSize;
+        sf::Vector2f corners[4] = { {x, y}, {x + t, y}, {x + t, y + t}, {x, y + t} };
+        sf::Vector2f texture[4] = { {0, 0}, {t, 0}, {t, t}, {0, t} };
+        static const int ORDER[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int k = 0; k < 6; ++k) {
+            batch.append(sf::Vertex(corners[ORDER[k]], texture[ORDER[k]]));
+        }
+    }
+
+    /**
+     * @brief Renders one glyph into a transparent tile-sized texture, at the
+     * offset the marks always had inside their cell.
+     */
+    void renderGlyph(const sf::Font& font, char mark, sf::RenderTexture& target) {
+        target.create(tileSize, tileSize);
+        target.clear(sf::Color::Transparent);
+        sf::Text text;
+        text.setFont(font);
+        text.setString(mark);
+        text.setCharacterSize(MARK_SIZE);
+        text.setPosition(15, -20);
+        text.setFillColor(sf::Color::Black);
+        target.draw(text);
+        target.display();
+        target.setSmooth(true);
+    }
+
+    int size;
+    int tileSize;
+    sf::VertexArray background;  ///< Grid and button rectangles.
+    sf::RenderTexture glyphs[2]; ///< X and O.
+    sf::VertexArray marks[2];    ///< Cells showing X and O.
+    std::vector<sf::Text> labels;
+    std::vector<char> cells;     ///< Board the marks were built from.
+    std::string overlay;         ///< Overlay text, empty when hidden.
+    sf::Text overlayText;
+    sf::RectangleShape overlayPanel;
+    bool dirty;
+};
+
+#endif // GAME_SCENE_H
@@ -0,0 +1,216 @@
+/**
+ * @file LatencyTrace.h
+ * @brief Per-stage round-trip latency of the commands the client sends.
+ *
+ * Every command is stamped when the UI queues it (the click), when the
+ * serial thread finished writing it, when the first byte of the reply was
+ * read and when the reply was parsed; the UI adds the time the board was
+ * updated. The four stages in between, and the whole round trip, each go
+ * into a LatencyHistogram:
+ *   click>write    command queue and port write
+ *   write>byte     wire time both ways and the Arduino
+ *   byte>parsed    rest of the reply and its parsing
+ *   parsed>board   message queue until the UI applied it
+ * Histograms are lock-free: recording is a few relaxed atomic adds, so any
+ * thread can record while another reads the percentiles for the HUD.
+ * Optionally every sample is also written as a CSV line.
+ */
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+typedef std::chrono::steady_clock TraceClock;
+
+/**
+ * @struct TraceStamps
+ * @brief Timestamps of one command, carried from the UI to the serial thread and back.
+ */
+struct TraceStamps {
+    TraceClock::time_point clicked;    ///< Queued by the UI.
+    TraceClock::time_point written;    ///< Written to the port.
+    TraceClock::time_point firstByte;  ///< First byte of the reply read.
+    TraceClock::time_point parsed;     ///< Reply parsed into a message.
+    uint8_t opcode;                    ///< Command (Protocol.h Opcode).
+    bool valid;                        ///< False for messages that answer no traced command.
+};
+
+/**
+ * @enum TraceStage
+ * @brief Stages of a round trip.
+ */
+enum TraceStage {
+    STAGE_WRITE = 0,
+    STAGE_ARDUINO = 1,
+    STAGE_PARSE = 2,
+    STAGE_UI = 3,
+    STAGE_TOTAL = 4,
+    TRACE_STAGES = 5
+};
+
+/// Names of the stages, indexed by TraceStage.
+const char* const TRACE_STAGE_NAMES[TRACE_STAGES] = { "click>write", "write>byte", "byte>parsed", "parsed>board", "click>board" };
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of microseconds, 8 buckets per power of two.
+ * Values below 8 us are exact; above, a bucket is at most 12.5% wide.
+ */
+class LatencyHistogram {
+public:
+    /// 8 exact buckets, then 8 per power of two up to 2^32 us.
+    static const int BUCKETS = 8 + 29 * 8;
+
+    LatencyHistogram() : count(0), maximum(0) {
+        for (int i = 0; i < BUCKETS; i++) counts[i].store(0, std::memory_order_relaxed);
+    }
+
+    /// Adds one sample (any thread).
+    void record(uint32_t us) {
+        counts[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        uint32_t seen = maximum.load(std::memory_order_relaxed);
+        while (us > seen && !maximum.compare_exchange_weak(seen, us, std::memory_order_relaxed)) {}
+    }
+
+    /// @return Samples recorded.
+    uint32_t samples() const { return count.load(std::memory_order_relaxed); }
+
+    /// @return Largest sample.
+    uint32_t max() const { return maximum.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Estimates a percentile.
+     * @param fraction 0.5 for p50, 0.99 for p99.
+     * @return Upper bound of the bucket holding the percentile, capped at max(); 0 without samples.
+     */
+    uint32_t percentile(double fraction) const {
+        uint32_t total = samples();
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(fraction * total + 0.5);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                uint32_t upper = upperBound(i);
+                return upper < max() ? upper : max();
+            }
+        }
+        return max();
+    }
+
+private:
+    static int bucketOf(uint32_t us) {
+        if (us < 8) return (int)us;
+        int msb = 3;
+        while ((us >> (msb + 1)) != 0) msb++;
+        return 8 + (msb - 3) * 8 + (int)((us >> (msb - 3)) & 7);
+    }
+
+    static uint32_t upperBound(int bucket) {
+        if (bucket < 8) return (uint32_t)bucket;
+        int shift = (bucket - 8) / 8;
+        uint64_t lower = (uint64_t)(8 + (bucket - 8) % 8) << shift;
+        uint64_t upper = lower + ((uint64_t)1 << shift) - 1;
+        return upper > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)upper;
+    }
+
+    std::atomic<uint32_t> counts[BUCKETS];
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> maximum;
+};
+
+/**
+ * @class LatencyTrace
+ * @brief Histograms of every stage and the optional CSV trace.
+ */
+class LatencyTrace {
+public:
+    LatencyTrace() : csv(NULL) {}
+    ~LatencyTrace() { closeCsv(); }
+
+    /**
+     * @brief Starts writing every sample to a CSV file.
+     * The file is written through a 64 KB buffer, so a sample costs one
+     * formatted line in memory.
+     * @return False if the file cannot be created.
+     */
+    bool openCsv(const char* path) {
+        closeCsv();
+        csv = std::fopen(path, "w");
+        if (csv == NULL) return false;
+        std::setvbuf(csv, NULL, _IOFBF, 1 << 16);
+        std::fprintf(csv, "opcode,click_us,click_write_us,write_byte_us,byte_parsed_us,parsed_board_us,total_us\n");
+        origin = TraceClock::now();
+        return true;
+    }
+
+    /// Flushes and closes the CSV file.
+    void closeCsv() {
+        if (csv != NULL) {
+            std::fclose(csv);
+            csv = NULL;
+        }
+    }
+
+    /**
+     * @brief Records the stages of one reply.
+     * @param stamps Stamps carried by the reply; ignored unless valid.
+     * @param applied When the UI applied the reply.
+     * @return True if a sample was recorded.
+     */
+    bool record(const TraceStamps& stamps, TraceClock::time_point applied) {
+        if (!stamps.valid) return false;
+        TraceClock::time_point firstByte = stamps.firstByte == TraceClock::time_point() ? stamps.parsed : stamps.firstByte;
+        uint32_t us[TRACE_STAGES] = {
+            micros(stamps.clicked, stamps.written),
+            micros(stamps.written, firstByte),
+            micros(firstByte, stamps.parsed),
+            micros(stamps.parsed, applied),
+            micros(stamps.clicked, applied)
+        };
+        for (int stage = 0; stage < TRACE_STAGES; stage++) stages[stage].record(us[stage]);
+        if (csv != NULL) {
+            std::fprintf(csv, "%u,%lld,%u,%u,%u,%u,%u\n", (unsigned)stamps.opcode,
+                (long long)std::chrono::duration_cast<std::chrono::microseconds>(stamps.clicked - origin).count(),
+                us[STAGE_WRITE], us[STAGE_ARDUINO], us[STAGE_PARSE], us[STAGE_UI], us[STAGE_TOTAL]);
+        }
+        return true;
+    }
+
+    /// @return Histogram of one stage.
+    const LatencyHistogram& stage(TraceStage which) const { return stages[which]; }
+
+    /**
+     * @brief Formats the HUD: one line per stage, p50/p95/p99/max in ms.
+     */
+    std::string summary() const {
+        char text[96];
+        std::snprintf(text, sizeof(text), "ms  p50/p95/p99/max  n=%u\n", stages[STAGE_TOTAL].samples());
+        std::string result = text;
+        for (int stage = 0; stage < TRACE_STAGES; stage++) {
+            const LatencyHistogram& h = stages[stage];
+            std::snprintf(text, sizeof(text), "%-12s %.1f/%.1f/%.1f/%.1f\n", TRACE_STAGE_NAMES[stage],
+                h.percentile(0.50) / 1000.0, h.percentile(0.95) / 1000.0, h.percentile(0.99) / 1000.0, h.max() / 1000.0);
+            result += text;
+        }
+        return result;
+    }
+
+private:
+    static uint32_t micros(TraceClock::time_point from, TraceClock::time_point to) {
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+        return us < 0 ? 0 : us > 0xFFFFFFFFLL ? 0xFFFFFFFFu : (uint32_t)us;
+    }
+
+    LatencyHistogram stages[TRACE_STAGES];
+    FILE* csv;                       ///< CSV trace, NULL if off.
+    TraceClock::time_point origin;   ///< click_us is relative to this.
+};
+
+#endif // LATENCY_TRACE_H
@@ -0,0 +1,178 @@
+/**
+ * @file Log.h
+ * @brief Buffered, level-gated log of the client.
+ *
+ * logMessage() checks the level before it formats anything, so a message
+ * below the configured level costs one atomic load. Enabled messages are
+ * formatted into the sink's buffer under a short lock; the sink's thread
+ * writes the buffer to the console (or a file) every FLUSH_MS. Neither the
+ * UI thread nor the serial thread ever waits on the console. Until start()
+ * and after stop(), messages are written directly.
+ */
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @enum LogLevel
+ * @brief Severity; a sink writes messages up to its level.
+ */
+enum LogLevel {
+    LOG_ERROR = 0, ///< Something failed.
+    LOG_WARN = 1,  ///< Something was dropped or retried.
+    LOG_INFO = 2,  ///< Startup and protocol state.
+    LOG_DEBUG = 3  ///< Every command and reply.
+};
+
+/**
+ * @brief Parses a level name from config.ini.
+ * @param name "error", "warn", "info" or "debug".
+ * @param fallback Level for anything else.
+ */
+inline LogLevel parseLogLevel(const std::string& name, LogLevel fallback) {
+    if (name == "error") return LOG_ERROR;
+    if (name == "warn") return LOG_WARN;
+    if (name == "info") return LOG_INFO;
+    if (name == "debug") return LOG_DEBUG;
+    return fallback;
+}
+
+/**
+ * @class LogSink
+ * @brief Collects log lines and writes them on its own thread.
+ */
+class LogSink {
+public:
+    /// Longest time a line waits in the buffer.
+    static const int FLUSH_MS = 100;
+    /// Bytes buffered at most; lines beyond that are counted and dropped.
+    static const size_t MAX_BUFFER = 1 << 20;
+
+    LogSink() : level(LOG_INFO), out(stdout), running(false), dropped(0) {}
+    ~LogSink() { stop(); }
+
+    /// Sets the most verbose level written.
+    void setLevel(LogLevel value) { level.store(value, std::memory_order_relaxed); }
+
+    /// @return True if messages of this level are written.
+    bool enabled(LogLevel value) const { return value <= level.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Writes to a file instead of the console (before start()).
+     * @return False if the file cannot be opened; the console is kept.
+     */
+    bool open(const char* path) {
+        FILE* file = std::fopen(path, "a");
+        if (file == NULL) return false;
+        out = file;
+        return true;
+    }
+
+    /// Starts the writer thread.
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) return;
+        running = true;
+        writer = std::thread(&LogSink::run, this);
+    }
+
+    /// Writes what is buffered and stops the writer thread.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_all();
+        writer.join();
+        if (out != stdout) {
+            std::fclose(out);
+            out = stdout;
+        }
+    }
+
+    /**
+     * @brief Formats and queues one line.
+     * @param value Level of the message.
+     * @param format printf format, without the newline.
+     * @param args Arguments of the format.
+     */
+    void write(LogLevel value, const char* format, va_list args) {
+        static const char* const TAGS[] = { "E ", "W ", "I ", "D " };
+        char line[512];
+        memcpy(line, TAGS[value], 2);
+        int length = std::vsnprintf(line + 2, sizeof(line) - 3, format, args);
+        if (length < 0) return;
+        if (length > (int)sizeof(line) - 4) length = (int)sizeof(line) - 4; // truncated
+        length += 2;
+        line[length++] = '\n';
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) {
+            std::fwrite(line, 1, length, out);
+        } else if (buffer.size() + length > MAX_BUFFER) {
+            dropped++;
+        } else {
+            buffer.append(line, length);
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::string batch;
+        for (;;) {
+            wake.wait_for(lock, std::chrono::milliseconds(FLUSH_MS), [this] { return !running; });
+            batch.swap(buffer);
+            unsigned long lost = dropped;
+            dropped = 0;
+            bool stopping = !running;
+            lock.unlock();
+            if (!batch.empty()) std::fwrite(batch.data(), 1, batch.size(), out);
+            if (lost > 0) std::fprintf(out, "W %lu log lines dropped\n", lost);
+            std::fflush(out);
+            batch.clear();
+            lock.lock();
+            if (stopping) return;
+        }
+    }
+
+    std::atomic<int> level;
+    FILE* out;                 ///< Console or log file.
+    bool running;              ///< mutex.
+    std::string buffer;        ///< Lines not written yet; mutex.
+    unsigned long dropped;     ///< Lines lost to a full buffer; mutex.
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread writer;
+};
+
+/// @return The client's log sink.
+inline LogSink& logSink() {
+    static LogSink sink;
+    return sink;
+}
+
+/**
+ * @brief Logs one printf-formatted line if its level is enabled.
+ * @param level Level of the message.
+ * @param format printf format, without the newline.
+ */
+inline void logMessage(LogLevel level, const char* format, ...) {
+    LogSink& sink = logSink();
+    if (!sink.enabled(level)) return;
+    va_list args;
+    va_start(args, format);
+    sink.write(level, format, args);
+    va_end(args);
+}
+
+#endif // LOG_H
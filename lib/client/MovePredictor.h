@@ -0,0 +1,113 @@
+/**
+ * @file MovePredictor.h
+ * @brief Speculative reply to the player's move, shown before the Arduino answers.
+ *
+ * The firmware AI is deterministic at TIER_NORMAL, so the client runs the
+ * same move selection (AiMove.h) on its copy of the board: the player's mark and the
+ * predicted AI reply are drawn as soon as the move is queued, instead of
+ * after the serial round trip and the search on the board. The Arduino stays
+ * authoritative. When its reply arrives the board is rolled back to the last
+ * confirmed position and replaced by (or rebuilt from) the reply; a reply
+ * that differs from the prediction counts as a misprediction. The budgeted
+ * tiers can be stopped by their time budget on the board, so their replies
+ * are not predicted (see predictable()).
+ */
+#ifndef MOVE_PREDICTOR_H
+#define MOVE_PREDICTOR_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "../arduino/task3/AiMove.h"
+
+/**
+ * @class MovePredictor
+ * @brief One predicted move in flight and the hit counters.
+ */
+class MovePredictor {
+public:
+    MovePredictor() : pending(false), predictions(0), mispredictions(0) {}
+
+    /**
+     * @brief Places the player's move and, against the AI, the predicted reply.
+     * Like the firmware, the AI replies even after a winning move and only
+     * skips its reply when the board is full. In PvP the mover's mark
+     * follows from the marks already placed.
+     * @param cells The shown board, 9 cells row by row; changed in place.
+     * @param cell Cell of the player's move.
+     * @param againstAi False in PvP.
+     */
+    void predict(char* cells, int cell, bool againstAi) {
+        memcpy(confirmed, cells, sizeof(confirmed));
+        if (againstAi) {
+            cells[cell] = 'X';
+            BitBoard b = {0, 0};
+            for (int i = 0; i < 9; i++) {
+                if (cells[i] == 'O') b.ai |= (uint16_t)1 << i;
+                else if (cells[i] != ' ') b.player |= (uint16_t)1 << i;
+            }
+            int8_t reply = chooseAiMove(b);
+            if (reply >= 0) cells[reply] = 'O';
+        } else {
+            int marks = 0;
+            for (int i = 0; i < 9; i++) marks += cells[i] != ' ';
+            cells[cell] = marks % 2 == 0 ? 'X' : 'O';
+        }
+        memcpy(predicted, cells, sizeof(predicted));
+        pending = true;
+    }
+
+    /**
+     * @brief Tells whether the replies of a game can be predicted.
+     * @param tier AiTier of the game.
+     * @return True at TIER_NORMAL, whose reply does not depend on timing.
+     */
+    static bool predictable(uint8_t tier) { return tier == TIER_NORMAL; }
+
+    /**
+     * @brief Puts the last confirmed board back while a prediction is pending.
+     * Call before applying a reply that only carries changes (DELTA) or none (NACK).
+     */
+    void rollback(char* cells) const {
+        if (pending) memcpy(cells, confirmed, sizeof(confirmed));
+    }
+
+    /**
+     * @brief Compares the Arduino's board with the pending prediction and settles it.
+     * @param cells The authoritative board.
+     * @return True if a prediction was pending and the board differs from it.
+     */
+    bool reconcile(const char* cells) {
+        if (!pending) return false;
+        pending = false;
+        predictions++;
+        if (memcmp(cells, predicted, sizeof(predicted)) == 0) return false;
+        mispredictions++;
+        return true;
+    }
+
+    /// Forgets a pending prediction; its reply belongs to a game that was reset.
+    void cancel() { pending = false; }
+
+    /// @return Predictions settled so far.
+    unsigned long settled() const { return predictions; }
+
+    /// @return Predictions the Arduino contradicted.
+    unsigned long missed() const { return mispredictions; }
+
+    /// @return "predicted N, mispredicted M" for the HUD.
+    std::string summary() const {
+        char text[64];
+        std::snprintf(text, sizeof(text), "predicted %lu, mispredicted %lu\n", predictions, mispredictions);
+        return text;
+    }
+
+private:
+    bool pending;                  ///< A move was predicted and its reply has not arrived.
+    char confirmed[9];             ///< Board before the predicted move.
+    char predicted[9];             ///< Board the prediction shows.
+    unsigned long predictions;     ///< Replies compared with a prediction.
+    unsigned long mispredictions;  ///< Replies that differed.
+};
+
+#endif // MOVE_PREDICTOR_H
@@ -0,0 +1,302 @@
+/**
+ * @file SerialPort.h
+ * @brief Serial port interface with Win32 and POSIX (termios) backends.
+ *
+ * PlatformSerialPort is the backend of the build platform: Win32SerialPort
+ * on Windows ("COM7"), PosixSerialPort elsewhere ("/dev/ttyACM0", or the
+ * pty printed by lib/host/virtual_arduino).
+ */
+#ifndef SERIAL_PORT_H
+#define SERIAL_PORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class SerialPort
+ * @brief Byte stream to the Arduino, 8N1.
+ */
+class SerialPort {
+public:
+    virtual ~SerialPort() {}
+
+    /**
+     * @brief Opens and configures the port.
+     * @param name Device name.
+     * @param baud Baud rate.
+     * @return True on success.
+     */
+    virtual bool open(const char* name, unsigned long baud) = 0;
+
+    /// Closes the port; safe to call when it is not open.
+    virtual void close() = 0;
+
+    /**
+     * @brief Changes the baud rate of the open port.
+     * @return False if the rate is not supported; the port keeps its rate.
+     */
+    virtual bool setBaud(unsigned long baud) = 0;
+
+    /// @return False if the backend cannot set this rate at all.
+    virtual bool supportsBaud(unsigned long baud) const = 0;
+
+    /// @return True while the port is open.
+    virtual bool isOpen() const = 0;
+
+    /**
+     * @brief Reads the bytes that have arrived.
+     * @param buffer Destination.
+     * @param size Capacity of buffer.
+     * @param waitMs Time to wait when nothing has arrived yet.
+     * @return Bytes read (0 on timeout), -1 on error.
+     */
+    virtual int read(uint8_t* buffer, size_t size, int waitMs) = 0;
+
+    /**
+     * @brief Writes bytes.
+     * @return Bytes written, -1 on error.
+     */
+    virtual int write(const uint8_t* data, size_t size) = 0;
+};
+
+#ifdef _WIN32
+
+/**
+ * @class Win32SerialPort
+ * @brief SerialPort on a Windows COM port.
+ */
+class Win32SerialPort : public SerialPort {
+public:
+    Win32SerialPort() : handle(INVALID_HANDLE_VALUE), readWait(-1) {}
+    ~Win32SerialPort() { close(); }
+
+    bool open(const char* name, unsigned long baud) {
+        close();
+        handle = CreateFileA(name, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        DCB dcbSerialParams = { 0 };
+        dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+        if (!GetCommState(handle, &dcbSerialParams)) {
+            close();
+            return false;
+        }
+        dcbSerialParams.BaudRate = (DWORD)baud;
+        dcbSerialParams.ByteSize = 8;
+        dcbSerialParams.StopBits = ONESTOPBIT;
+        dcbSerialParams.Parity = NOPARITY;
+        if (!SetCommState(handle, &dcbSerialParams)) {
+            close();
+            return false;
+        }
+        readWait = -1;
+        return true;
+    }
+
+    bool setBaud(unsigned long baud) {
+        DCB dcbSerialParams = { 0 };
+        dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+        if (!GetCommState(handle, &dcbSerialParams)) {
+            return false;
+        }
+        dcbSerialParams.BaudRate = (DWORD)baud;
+        return SetCommState(handle, &dcbSerialParams) != 0;
+    }
+
+    /// Any rate: the driver of the USB serial chip rejects what it cannot do.
+    bool supportsBaud(unsigned long) const { return true; }
+
+    void close() {
+        if (handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(handle);
+            handle = INVALID_HANDLE_VALUE;
+        }
+    }
+
+    bool isOpen() const { return handle != INVALID_HANDLE_VALUE; }
+
+    int read(uint8_t* buffer, size_t size, int waitMs) {
+        if (waitMs != readWait && !setReadWait(waitMs)) {
+            return -1;
+        }
+        DWORD count = 0;
+        if (!ReadFile(handle, buffer, (DWORD)size, &count, NULL)) {
+            return -1;
+        }
+        return (int)count;
+    }
+
+    int write(const uint8_t* data, size_t size) {
+        DWORD count = 0;
+        if (!WriteFile(handle, data, (DWORD)size, &count, NULL)) {
+            return -1;
+        }
+        return (int)count;
+    }
+
+private:
+    /**
+     * @brief Makes ReadFile() return at once when bytes are waiting,
+     * otherwise after waitMs.
+     */
+    bool setReadWait(int waitMs) {
+        COMMTIMEOUTS timeouts = { 0 };
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutMultiplier = waitMs > 0 ? MAXDWORD : 0;
+        timeouts.ReadTotalTimeoutConstant = waitMs > 0 ? (DWORD)waitMs : 0;
+        timeouts.WriteTotalTimeoutConstant = 50;
+        timeouts.WriteTotalTimeoutMultiplier = 10;
+        if (!SetCommTimeouts(handle, &timeouts)) {
+            return false;
+        }
+        readWait = waitMs;
+        return true;
+    }
+
+    HANDLE handle;
+    int readWait; ///< waitMs the timeouts are set for, -1 if unknown.
+};
+
+typedef Win32SerialPort PlatformSerialPort;
+
+#else
+
+/**
+ * @class PosixSerialPort
+ * @brief SerialPort on a tty device (termios, raw mode).
+ */
+class PosixSerialPort : public SerialPort {
+public:
+    PosixSerialPort() : fd(-1) {}
+    ~PosixSerialPort() { close(); }
+
+    bool open(const char* name, unsigned long baud) {
+        close();
+        speed_t speed = toSpeed(baud);
+        if (speed == B0) {
+            return false;
+        }
+        fd = ::open(name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        termios settings;
+        if (tcgetattr(fd, &settings) != 0) {
+            close();
+            return false;
+        }
+        cfmakeraw(&settings);
+        settings.c_cflag |= CLOCAL | CREAD;
+        settings.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+        settings.c_cc[VMIN] = 0;
+        settings.c_cc[VTIME] = 0;
+        cfsetispeed(&settings, speed);
+        cfsetospeed(&settings, speed);
+        if (tcsetattr(fd, TCSANOW, &settings) != 0) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    bool setBaud(unsigned long baud) {
+        speed_t speed = toSpeed(baud);
+        termios settings;
+        if (speed == B0 || tcgetattr(fd, &settings) != 0) {
+            return false;
+        }
+        cfsetispeed(&settings, speed);
+        cfsetospeed(&settings, speed);
+        return tcsetattr(fd, TCSADRAIN, &settings) == 0;
+    }
+
+    bool supportsBaud(unsigned long baud) const { return toSpeed(baud) != B0; }
+
+    bool isOpen() const { return fd >= 0; }
+
+    /// @return The tty's file descriptor for poll()/epoll, -1 when closed.
+    int descriptor() const { return fd; }
+
+    int read(uint8_t* buffer, size_t size, int waitMs) {
+        pollfd ready = { fd, POLLIN, 0 };
+        int events = poll(&ready, 1, waitMs);
+        if (events <= 0) {
+            return events;
+        }
+        ssize_t count = ::read(fd, buffer, size);
+        return count < 0 ? -1 : (int)count;
+    }
+
+    int write(const uint8_t* data, size_t size) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t count = ::write(fd, data + done, size - done);
+            if (count < 0) {
+                return -1;
+            }
+            done += (size_t)count;
+        }
+        return (int)done;
+    }
+
+    /**
+     * @brief Maps a baud rate to its termios speed.
+     * @return B0 if the platform has no constant for it.
+     */
+    static speed_t toSpeed(unsigned long baud) {
+        switch (baud) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+#ifdef B500000
+        case 500000: return B500000;
+        case 1000000: return B1000000;
+#endif
+        default: return B0;
+        }
+    }
+
+    /**
+     * @brief Maps a termios speed back to its baud rate.
+     * @return 0 for speeds toSpeed() does not produce.
+     */
+    static unsigned long toBaud(speed_t speed) {
+        static const unsigned long RATES[] = { 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 500000, 1000000 };
+        for (size_t i = 0; i < sizeof(RATES) / sizeof(RATES[0]); i++) {
+            if (toSpeed(RATES[i]) == speed && speed != B0) return RATES[i];
+        }
+        return 0;
+    }
+
+private:
+    int fd;
+};
+
+typedef PosixSerialPort PlatformSerialPort;
+
+#endif
+
+#endif // SERIAL_PORT_H
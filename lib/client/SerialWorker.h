@@ -0,0 +1,571 @@
+/**
+ * @file SerialWorker.h
+ * @brief Serial I/O thread of the client.
+ *
+ * The worker owns the serial port: it writes the commands the UI queues,
+ * reads whatever the Arduino sends, reassembles text lines or binary frames
+ * (Protocol.h) across reads and hands parsed messages back. Both directions
+ * go through SpscQueue, so the UI thread never touches the port and never
+ * blocks on it. Each command carries the TraceStamps of its round trip
+ * (LatencyTrace.h); the worker fills in its part and returns them with the
+ * reply. Traffic is logged at LOG_DEBUG through the buffered log sink.
+ * An optional UiWakeup is signaled after every message, so the UI thread
+ * can sleep until a reply instead of polling for one.
+ *
+ * With a maximum rate set, the worker first negotiates the link speed
+ * (Link.h): it asks the board for its rates at the safe rate the port was
+ * opened at, and tries them from the fastest down, keeping the first that
+ * echoes the test pattern without a byte error. When a raised link fails
+ * later (a binary command unanswered, or garbled text lines), it goes back
+ * to the safe rate, where the board has fallen back too, and negotiates
+ * again.
+ */
+#ifndef SERIAL_WORKER_H
+#define SERIAL_WORKER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include "LatencyTrace.h"
+#include "Log.h"
+#include "SerialPort.h"
+#include "SpscQueue.h"
+#include "UiWakeup.h"
+#include "../arduino/task3/Protocol.h"
+#include "../arduino/task3/Link.h"
+#include "../arduino/task3/AiMove.h"
+
+/**
+ * @struct SerialCommand
+ * @brief Command queued by the UI.
+ */
+struct SerialCommand {
+    uint8_t opcode; ///< OP_RESET, OP_MODE, OP_MOVE or OP_LED.
+    uint8_t value;  ///< GameMode, cell index (row * 3 + col) or LED (0 blue, 1 yellow).
+    uint8_t tier;   ///< OP_MODE: AiTier of the game.
+    TraceClock::time_point clicked; ///< When the UI queued it.
+};
+
+/**
+ * @struct SerialMessage
+ * @brief Parsed message from the Arduino.
+ */
+struct SerialMessage {
+    enum Kind : uint8_t {
+        BOARD,  ///< Full board in cells.
+        DELTA,  ///< Moves in delta (Protocol.h encoding) and status.
+        STATUS, ///< Result line of the text protocol in status.
+        NACK    ///< Command rejected or not answered.
+    };
+    Kind kind;          ///< Message type.
+    char cells[9];      ///< BOARD: row-major cells.
+    uint8_t delta[2];   ///< DELTA: moves applied, NO_DELTA if unused.
+    uint8_t status;     ///< DELTA, STATUS: GameStatus.
+    TraceStamps trace;  ///< Round trip of the command this answers, if valid.
+};
+
+/**
+ * @class SerialWorker
+ * @brief Background thread between the UI and the serial port.
+ */
+class SerialWorker {
+public:
+    /// Longest wait of one SerialPort::read() call in the worker.
+    static const int READ_WAIT_MS = 5;
+    /// Time to wait for a binary reply before sending the command again.
+    static const int REPLY_TIMEOUT_MS = 1000;
+    /// Sends of one binary command before giving up.
+    static const int SEND_ATTEMPTS = 3;
+    /// Longest text line kept while waiting for its newline.
+    static const size_t MAX_LINE = 64;
+    /// Rate queries before giving up on negotiation; the Uno may still be in its bootloader.
+    static const int QUERY_ATTEMPTS = 4;
+    /// Test pattern round trips a new rate has to pass.
+    static const int SYNC_ROUNDS = 8;
+    /// Longest wait for one echo at a new rate.
+    static const int SYNC_TIMEOUT_MS = 200;
+
+    SerialWorker() : port(NULL), wakeup(NULL), running(false), binaryMode(false),
+                     safeBaud(0), maxBaud(0), baud(0), linkBytes(0), linkErrors(0) {}
+    ~SerialWorker() { stop(); }
+
+    /**
+     * @brief Wakes the UI thread after every message (call before start()).
+     * @param signal Wakeup the UI thread waits on, or NULL.
+     */
+    void setWakeup(UiWakeup* signal) { wakeup = signal; }
+
+    /**
+     * @brief Negotiates the link speed on start (call before start()).
+     * @param openedAt Rate the port is open at; the board's default rate.
+     * @param highest Fastest rate to try; at most openedAt keeps the rate.
+     */
+    void setLinkRates(unsigned long openedAt, unsigned long highest) {
+        safeBaud = openedAt;
+        maxBaud = highest;
+        baud = openedAt;
+    }
+
+    /**
+     * @brief Starts the thread.
+     * @param serialPort Open port, used only by the worker until stop().
+     * @param binary Try to switch the Arduino to binary frames first.
+     */
+    void start(SerialPort& serialPort, bool binary) {
+        port = &serialPort;
+        running = true;
+        thread = std::thread(&SerialWorker::run, this, binary);
+    }
+
+    /**
+     * @brief Stops the thread; the port stays open.
+     */
+    void stop() {
+        running = false;
+        if (thread.joinable()) thread.join();
+    }
+
+    /**
+     * @brief Queues a command (UI thread only).
+     * @param tier OP_MODE: AiTier of the new game.
+     * @return False if the queue is full.
+     */
+    bool send(uint8_t opcode, uint8_t value, uint8_t tier = TIER_NORMAL) {
+        SerialCommand command = { opcode, value, tier, TraceClock::now() };
+        return commands.push(command);
+    }
+
+    /**
+     * @brief Takes the next parsed message (UI thread only).
+     * @return False if there is none.
+     */
+    bool poll(SerialMessage& message) { return messages.pop(message); }
+
+    /// @return True if the Arduino acknowledged binary frames.
+    bool binary() const { return binaryMode; }
+
+    /// @return Current rate of the link, 0 if setLinkRates() was not called.
+    unsigned long linkBaud() const { return baud; }
+
+    /// @return "link N baud, E errors in B bytes (R%)" for the HUD.
+    std::string linkSummary() const {
+        unsigned long bytes = linkBytes;
+        unsigned long errors = linkErrors;
+        char text[96];
+        std::snprintf(text, sizeof(text), "link %lu baud, %lu errors in %lu bytes (%.3f%%)\n",
+            (unsigned long)baud, errors, bytes, bytes > 0 ? 100.0 * errors / bytes : 0.0);
+        return text;
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void run(bool binary) {
+        bool raised = maxBaud > safeBaud && negotiate();
+        if (binary) binaryMode = handshake(raised);
+        while (running) {
+            SerialCommand command;
+            if (!pending && commands.pop(command)) writeCommand(command);
+            readAvailable();
+            if (pending && Clock::now() - sentAt > std::chrono::milliseconds(REPLY_TIMEOUT_MS)) retransmit();
+            if (linkLost) recoverLink(binary);
+        }
+        if (binaryMode) {
+            // Leave the Arduino in text mode for the next client.
+            uint8_t bye[FRAME_SIZE];
+            encodeFrame(makeFrame(OP_HELLO, (seq + 1) & 0x07, 0), bye);
+            write(bye, FRAME_SIZE);
+        }
+        if (baud != safeBaud) {
+            // And at the rate the next client opens the port at.
+            char request[32];
+            int length = std::snprintf(request, sizeof(request), "\nbaud %lu\n", safeBaud);
+            write(request, (size_t)length);
+        }
+    }
+
+    /**
+     * @brief Switches the Arduino to binary frames.
+     * A HELLO frame goes first in case the Arduino still talks binary from an
+     * earlier session, then "bin" (after a newline that ends any partial text
+     * command).
+     * @param textMode The Arduino just answered text commands: no HELLO
+     *                 probe, whose bytes would count as link errors there.
+     * @return True if the Arduino acknowledged binary frames.
+     */
+    bool handshake(bool textMode) {
+        if (!textMode) {
+            uint8_t hello[FRAME_SIZE];
+            seq = (seq + 1) & 0x07;
+            encodeFrame(makeFrame(OP_HELLO, seq, PROTOCOL_VERSION), hello);
+            write(hello, FRAME_SIZE);
+            if (awaitHello(REPLY_TIMEOUT_MS / 2)) return true;
+        }
+        write("\nbin\n", 5);
+        if (awaitHello(REPLY_TIMEOUT_MS)) return true;
+        logMessage(LOG_INFO, "[Frontend] No binary protocol, using text commands");
+        return false;
+    }
+
+    /**
+     * @brief Waits for a HELLO frame with this protocol version.
+     * @param timeoutMs Longest wait.
+     * @return True if it arrived.
+     */
+    bool awaitHello(int timeoutMs) {
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (running && Clock::now() < deadline) {
+            uint8_t buffer[64];
+            int count = read(buffer, sizeof(buffer));
+            Frame frame;
+            for (int i = 0; i < count; i++) {
+                if (frameReader.push(buffer[i], frame) && frame.opcode == OP_HELLO && frame.payload[0] == PROTOCOL_VERSION) {
+                    logMessage(LOG_INFO, "[Frontend] Binary protocol v%d enabled", (int)PROTOCOL_VERSION);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Raises the link to the fastest rate both ends carry cleanly.
+     * @return False if the board does not negotiate or no faster rate passed.
+     */
+    bool negotiate() {
+        std::string reply;
+        bool listed = false;
+        for (int i = 0; i < QUERY_ATTEMPTS && running && !listed; i++) {
+            write("\nbaud\n", 6);
+            listed = awaitLine("baud ", REPLY_TIMEOUT_MS, reply);
+        }
+        if (!listed) {
+            logMessage(LOG_INFO, "[Frontend] No link negotiation, staying at %lu baud", safeBaud);
+            return false;
+        }
+        std::vector<unsigned long> rates;
+        for (const char* next = reply.c_str() + 4; *next == ' ';) {
+            char* end;
+            rates.push_back(std::strtoul(next + 1, &end, 10));
+            next = end;
+        }
+        for (size_t i = rates.size(); i-- > 0;) {
+            if (rates[i] > safeBaud && rates[i] <= maxBaud && port->supportsBaud(rates[i]) && tryRate(rates[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Switches both ends to a rate and runs the test pattern.
+     * On any error the port goes back to the safe rate and waits until the
+     * board's trial has run out, so both ends are there again.
+     * @return True if the board confirmed the rate.
+     */
+    bool tryRate(unsigned long rate) {
+        char request[32];
+        int length = std::snprintf(request, sizeof(request), "baud %lu\n", rate);
+        write(request, (size_t)length);
+        std::string reply;
+        request[length - 1] = '\0';
+        if (!awaitLine("baud ", REPLY_TIMEOUT_MS, reply) || reply != std::string(request) + " ok") {
+            logMessage(LOG_INFO, "[Frontend] Board refused %lu baud", rate);
+            return false;
+        }
+        if (!port->setBaud(rate)) {
+            logMessage(LOG_WARN, "[Frontend] Port cannot switch to %lu baud", rate);
+            revertRate();
+            return false;
+        }
+        const std::string sync = std::string("sync ") + LINK_PATTERN;
+        unsigned long errors = 0;
+        for (int round = 0; round < SYNC_ROUNDS && errors == 0 && running; round++) {
+            write((sync + "\n").c_str(), sync.size() + 1);
+            if (!awaitLine("", SYNC_TIMEOUT_MS, reply)) {
+                errors++;
+                continue;
+            }
+            errors += reply.size() > sync.size() ? reply.size() - sync.size() : sync.size() - reply.size();
+            for (size_t i = 0; i < reply.size() && i < sync.size(); i++) errors += reply[i] != sync[i];
+        }
+        if (errors == 0) {
+            write("baud ok\n", 8);
+            if (awaitLine("", SYNC_TIMEOUT_MS, reply) && reply == "baud ok") {
+                baud = rate;
+                logMessage(LOG_INFO, "[Frontend] Link at %lu baud, %d test patterns clean", rate, SYNC_ROUNDS);
+                return true;
+            }
+            errors++;
+        }
+        linkErrors += errors;
+        logMessage(LOG_INFO, "[Frontend] %lu baud failed the test pattern (%lu byte errors)", rate, errors);
+        revertRate();
+        return false;
+    }
+
+    /// Back to the safe rate once the board's unconfirmed trial has run out.
+    void revertRate() {
+        port->setBaud(safeBaud);
+        baud = safeBaud;
+        std::string ignored;
+        awaitLine("\n", (int)LINK_TRIAL_MS + SYNC_TIMEOUT_MS, ignored);
+    }
+
+    /**
+     * @brief Goes back to the safe rate after link errors and negotiates again.
+     * The board is asked to come along; if it does not hear that, its own
+     * error count sends it back.
+     * @param binary Switch to binary frames again afterwards.
+     */
+    void recoverLink(bool binary) {
+        linkLost = false;
+        garbledLines = 0;
+        logMessage(LOG_WARN, "[Frontend] Link errors at %lu baud, back to %lu", (unsigned long)baud, safeBaud);
+        if (binaryMode) {
+            uint8_t bye[FRAME_SIZE];
+            encodeFrame(makeFrame(OP_HELLO, (seq + 1) & 0x07, 0), bye);
+            write(bye, FRAME_SIZE);
+            binaryMode = false;
+        }
+        char request[32];
+        int length = std::snprintf(request, sizeof(request), "\nbaud %lu\n", safeBaud);
+        write(request, (size_t)length);
+        std::string ignored;
+        awaitLine("\n", SYNC_TIMEOUT_MS, ignored);
+        port->setBaud(safeBaud);
+        baud = safeBaud;
+        line.clear();
+        frameReader.reset();
+        bool raised = negotiate();
+        if (binary) binaryMode = handshake(raised);
+    }
+
+    /**
+     * @brief Reads until a text line starting with prefix arrives; other lines are dropped.
+     * @param prefix Start of the line wanted; "\n" matches no line (drains for the whole wait).
+     * @param timeoutMs Longest wait.
+     * @param found Set to the line, without its line end.
+     * @return True if the line arrived.
+     */
+    bool awaitLine(const char* prefix, int timeoutMs, std::string& found) {
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        line.clear();
+        while (running && Clock::now() < deadline) {
+            uint8_t buffer[64];
+            int count = read(buffer, sizeof(buffer));
+            for (int i = 0; i < count; i++) {
+                countLinkByte(buffer[i]);
+                if (buffer[i] != '\n') {
+                    if (line.size() < MAX_LINE) line.push_back((char)buffer[i]);
+                    continue;
+                }
+                if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+                logMessage(LOG_DEBUG, "[Backend] Received from Arduino: %s", line.c_str());
+                bool match = line.compare(0, strlen(prefix), prefix) == 0;
+                found.swap(line);
+                line.clear();
+                if (match) return true;
+            }
+        }
+        return false;
+    }
+
+    /// Counts a received byte; in text mode, non-printable bytes are link errors.
+    void countLinkByte(uint8_t byte) {
+        linkBytes++;
+        if (!binaryMode && (byte < ' ' || byte > '~') && byte != '\n' && byte != '\r') {
+            linkErrors++;
+            lineGarbled = true;
+        }
+    }
+
+    void writeCommand(const SerialCommand& command) {
+        tracing = TraceStamps();
+        tracing.clicked = command.clicked;
+        tracing.opcode = command.opcode;
+        if (binaryMode) {
+            seq = (seq + 1) & 0x07;
+            encodeFrame(makeFrame(command.opcode, seq, command.value, command.tier), pendingFrame);
+            pending = true;
+            attempts = 0;
+            retransmit();
+            tracing.written = Clock::now();
+            tracing.valid = true;
+            return;
+        }
+        static const char* const MODE_COMMANDS[] = { "player\n", "ai\n", "pvp\n" };
+        std::string text;
+        switch (command.opcode) {
+        case OP_RESET: text = "reset\n"; break;
+        case OP_MODE: text = std::string(AI_TIER_NAMES[command.tier]) + "\n" + MODE_COMMANDS[command.value]; break;
+        case OP_MOVE: text = std::to_string(command.value / 3) + "," + std::to_string(command.value % 3) + "\n"; break;
+        case OP_LED: text = command.value == 0 ? "BLed\n" : "Yled\n"; break;
+        default: return;
+        }
+        write(text.c_str(), text.size());
+        tracing.written = Clock::now();
+        tracing.valid = true;
+        logMessage(LOG_DEBUG, "[Frontend] Sent to Arduino: %.*s", (int)text.size() - 1, text.c_str());
+    }
+
+    /**
+     * @brief Sends the pending frame, or gives up after SEND_ATTEMPTS.
+     */
+    void retransmit() {
+        if (attempts == SEND_ATTEMPTS) {
+            logMessage(LOG_WARN, "[Frontend] No reply from Arduino!");
+            if (baud != safeBaud) linkLost = true;
+            pending = false;
+            tracing.valid = false;
+            SerialMessage message = {};
+            message.kind = SerialMessage::NACK;
+            post(message);
+            return;
+        }
+        attempts++;
+        write(pendingFrame, FRAME_SIZE);
+        sentAt = Clock::now();
+    }
+
+    void readAvailable() {
+        uint8_t buffer[256];
+        int count = read(buffer, sizeof(buffer));
+        if (count > 0 && tracing.valid && tracing.firstByte == Clock::time_point()) {
+            tracing.firstByte = Clock::now();
+        }
+        uint16_t frameErrors = frameReader.errors;
+        for (int i = 0; i < count; i++) {
+            countLinkByte(buffer[i]);
+            if (binaryMode) {
+                Frame frame;
+                if (frameReader.push(buffer[i], frame)) handleFrame(frame);
+            } else if (buffer[i] == '\n') {
+                // A run of garbled lines means the board is at another rate.
+                garbledLines = lineGarbled ? garbledLines + 1 : 0;
+                lineGarbled = false;
+                if (garbledLines >= LINK_ERROR_LIMIT && baud != safeBaud) linkLost = true;
+                handleLine();
+                line.clear();
+            } else if (line.size() < MAX_LINE) {
+                line.push_back((char)buffer[i]);
+            }
+        }
+        linkErrors += (uint16_t)(frameReader.errors - frameErrors);
+    }
+
+    /**
+     * @brief Parses one complete text line: a board or a result.
+     * Anything else (test output, errors) is only logged.
+     */
+    void handleLine() {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        logMessage(LOG_DEBUG, "[Backend] Received from Arduino: %s", line.c_str());
+        SerialMessage message = {};
+        if (line.size() == 9 && line.find_first_not_of(" XO") == std::string::npos) {
+            message.kind = SerialMessage::BOARD;
+            memcpy(message.cells, line.data(), 9);
+            attachTrace(message);
+            post(message);
+            return;
+        }
+        for (uint8_t status = STATUS_X_WIN; status <= STATUS_DRAW; status++) {
+            if (line == statusText(status)) {
+                message.kind = SerialMessage::STATUS;
+                message.status = status;
+                post(message);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Turns the reply to the pending command into a message.
+     * Frames with another sequence number are late replies already answered.
+     */
+    void handleFrame(const Frame& frame) {
+        if (!pending || frame.seq != seq) return;
+        pending = false;
+        SerialMessage message = {};
+        switch (frame.opcode) {
+        case OP_BOARD:
+            message.kind = SerialMessage::BOARD;
+            message.status = unpackBoard(frame.payload, message.cells);
+            break;
+        case OP_DELTA:
+            message.kind = SerialMessage::DELTA;
+            message.delta[0] = frame.payload[0];
+            message.delta[1] = frame.payload[1];
+            message.status = frame.payload[2];
+            break;
+        default:
+            message.kind = SerialMessage::NACK;
+            break;
+        }
+        attachTrace(message);
+        post(message);
+    }
+
+    /// Hands the stamps of the command in flight to its reply.
+    void attachTrace(SerialMessage& message) {
+        if (!tracing.valid) return;
+        message.trace = tracing;
+        message.trace.parsed = Clock::now();
+        tracing.valid = false;
+    }
+
+    void post(const SerialMessage& message) {
+        // The UI drains the queue whenever it wakes; a full queue means it stopped.
+        if (!messages.push(message)) logMessage(LOG_WARN, "[Frontend] Message queue full, reply dropped");
+        if (wakeup != NULL) wakeup->wake();
+    }
+
+    void write(const void* data, size_t size) {
+        if (port->write((const uint8_t*)data, size) < 0) {
+            logMessage(LOG_ERROR, "[Frontend] Error sending to Arduino!");
+        }
+    }
+
+    int read(uint8_t* buffer, size_t size) {
+        int count = port->read(buffer, size, READ_WAIT_MS);
+        if (count < 0) {
+            // Port gone (unplugged): do not spin.
+            std::this_thread::sleep_for(std::chrono::milliseconds(READ_WAIT_MS));
+            return 0;
+        }
+        return count;
+    }
+
+    SerialPort* port;
+    UiWakeup* wakeup;  ///< Signaled after every message, if set.
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<bool> binaryMode;
+    unsigned long safeBaud;  ///< Rate the port was opened at.
+    unsigned long maxBaud;   ///< Fastest rate to negotiate.
+    std::atomic<unsigned long> baud;       ///< Current rate.
+    std::atomic<unsigned long> linkBytes;  ///< Bytes received.
+    std::atomic<unsigned long> linkErrors; ///< Garbled bytes, pattern errors and dropped frame bytes.
+    SpscQueue<SerialCommand, 16> commands;
+    SpscQueue<SerialMessage, 64> messages;
+
+    // Worker thread only.
+    std::string line;
+    FrameReader frameReader;
+    uint8_t seq = 0;
+    uint8_t pendingFrame[FRAME_SIZE];
+    bool pending = false;
+    int attempts = 0;
+    Clock::time_point sentAt;
+    bool linkLost = false;     ///< The raised rate failed; recoverLink() is due.
+    bool lineGarbled = false;  ///< The text line being received has a non-printable byte.
+    int garbledLines = 0;      ///< Garbled text lines in a row.
+    TraceStamps tracing = TraceStamps(); ///< Command in flight; valid until its reply.
+};
+
+#endif // SERIAL_WORKER_H
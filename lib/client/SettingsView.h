@@ -0,0 +1,144 @@
+/**
+ * @file SettingsView.h
+ * @brief LED settings, drawn in the game window instead of a window of their own.
+ *
+ * The view is built once with the game scene and shown in its place while
+ * settings are open, so opening them creates no window and no GL context,
+ * and the main loop keeps serving the serial replies meanwhile. Like
+ * GameScene it presents a frame only when something changed.
+ */
+#ifndef SETTINGS_VIEW_H
+#define SETTINGS_VIEW_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+/**
+ * @class SettingsView
+ * @brief Buttons that toggle the blue and yellow LEDs, pick the AI tier, and a way back to the game.
+ */
+class SettingsView {
+public:
+    /**
+     * @enum Action
+     * @brief What a click on the view asks for.
+     */
+    enum Action {
+        NONE,   ///< Click outside the buttons.
+        BLUE,   ///< Toggle the blue LED.
+        YELLOW, ///< Toggle the yellow LED.
+        TIER,   ///< Switch to the next AI tier.
+        BACK    ///< Close the settings.
+    };
+
+    /**
+     * @brief Lays out the buttons, centered horizontally.
+     * @param font Font of the labels.
+     * @param width Width of the window.
+     */
+    SettingsView(const sf::Font& font, float width) : blue(true), yellow(true), tier(""), dirty(true) {
+        float left = (width - 200) / 2;
+        setupButton(blueButton, blueText, font, left, 50, sf::Color::Blue, sf::Color::White);
+        setupButton(yellowButton, yellowText, font, left, 150, sf::Color::Yellow, sf::Color::Black);
+        setupButton(tierButton, tierText, font, left, 250, sf::Color::Magenta, sf::Color::White);
+        setupButton(backButton, backText, font, left, 350, sf::Color::Green, sf::Color::White);
+        backText.setString("Back");
+        setLeds(false, false);
+        setTier("normal");
+    }
+
+    /**
+     * @brief Shows the LED states on the buttons.
+     * @param blueOn Blue LED on.
+     * @param yellowOn Yellow LED on.
+     */
+    void setLeds(bool blueOn, bool yellowOn) {
+        if (blueOn == blue && yellowOn == yellow) {
+            return;
+        }
+        blue = blueOn;
+        yellow = yellowOn;
+        blueText.setString(blue ? "Blue LED: ON" : "Blue LED: OFF");
+        yellowText.setString(yellow ? "Yellow LED: ON" : "Yellow LED: OFF");
+        dirty = true;
+    }
+
+    /**
+     * @brief Shows the AI tier of the next games on its button.
+     * @param name Name of the tier (AI_TIER_NAMES).
+     */
+    void setTier(const char* name) {
+        if (name == tier) {
+            return;
+        }
+        tier = name;
+        tierText.setString(std::string("AI: ") + name);
+        dirty = true;
+    }
+
+    /**
+     * @brief Maps a click to the button under it.
+     * @param x Window x coordinate.
+     * @param y Window y coordinate.
+     */
+    Action click(int x, int y) const {
+        if (blueButton.getGlobalBounds().contains((float)x, (float)y)) return BLUE;
+        if (yellowButton.getGlobalBounds().contains((float)x, (float)y)) return YELLOW;
+        if (tierButton.getGlobalBounds().contains((float)x, (float)y)) return TIER;
+        if (backButton.getGlobalBounds().contains((float)x, (float)y)) return BACK;
+        return NONE;
+    }
+
+    /// Forces a redraw, e.g. when the view is shown again.
+    void invalidate() { dirty = true; }
+
+    /**
+     * @brief Draws and presents the frame if anything changed.
+     * @param window Target window.
+     * @return True if a frame was presented.
+     */
+    bool present(sf::RenderWindow& window) {
+        if (!dirty) {
+            return false;
+        }
+        window.clear(sf::Color::White);
+        window.draw(blueButton);
+        window.draw(blueText);
+        window.draw(yellowButton);
+        window.draw(yellowText);
+        window.draw(tierButton);
+        window.draw(tierText);
+        window.draw(backButton);
+        window.draw(backText);
+        window.display();
+        dirty = false;
+        return true;
+    }
+
+private:
+    static void setupButton(sf::RectangleShape& button, sf::Text& text, const sf::Font& font,
+                            float x, float y, sf::Color fill, sf::Color ink) {
+        button.setSize(sf::Vector2f(200, 50));
+        button.setPosition(x, y);
+        button.setFillColor(fill);
+        text.setFont(font);
+        text.setCharacterSize(20);
+        text.setFillColor(ink);
+        text.setPosition(x + 20, y + 10);
+    }
+
+    bool blue;      ///< Blue LED state shown.
+    bool yellow;    ///< Yellow LED state shown.
+    std::string tier; ///< Tier name shown.
+    sf::RectangleShape blueButton;
+    sf::Text blueText;
+    sf::RectangleShape yellowButton;
+    sf::Text yellowText;
+    sf::RectangleShape tierButton;
+    sf::Text tierText;
+    sf::RectangleShape backButton;
+    sf::Text backText;
+    bool dirty;
+};
+
+#endif // SETTINGS_VIEW_H
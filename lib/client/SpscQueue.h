@@ -0,0 +1,64 @@
+/**
+ * @file SpscQueue.h
+ * @brief Bounded lock-free queue for one producer thread and one consumer thread.
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscQueue
+ * @brief Ring buffer connecting exactly one producer to exactly one consumer.
+ * head is written only by the consumer and tail only by the producer; the
+ * release store of an index publishes the slot written before it, so
+ * neither side ever takes a lock or waits.
+ * @tparam T Element type, copied in and out.
+ * @tparam Capacity Number of slots, a power of two.
+ */
+template <class T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    /**
+     * @brief Appends an element (producer thread only).
+     * @param item Element to copy in.
+     * @return False if the queue is full.
+     */
+    bool push(const T& item) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == Capacity) return false;
+        items[position & (Capacity - 1)] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element (consumer thread only).
+     * @param item Receives the element.
+     * @return False if the queue is empty.
+     */
+    bool pop(T& item) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) return false;
+        item = items[position & (Capacity - 1)];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @return True if nothing is queued (exact only on the consumer thread).
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head; ///< Next slot to read.
+    alignas(64) std::atomic<size_t> tail; ///< Next slot to write.
+    T items[Capacity];
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,85 @@
+/**
+ * @file UiWakeup.h
+ * @brief Lets the UI thread sleep until there is something to do.
+ *
+ * The UI thread waits here between frames; the serial worker calls wake()
+ * after every message it queues. On Windows the wait also ends on any input
+ * for the thread's windows (MsgWaitForMultipleObjectsEx), so an idle client
+ * sleeps until a click, a key, a reply or its timeout. SFML does not expose
+ * the X11 connection, so elsewhere window input is picked up by waking every
+ * INPUT_WAIT_MS.
+ */
+#ifndef UI_WAKEUP_H
+#define UI_WAKEUP_H
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/**
+ * @class UiWakeup
+ * @brief Auto-reset signal from any thread to the UI thread.
+ */
+class UiWakeup {
+public:
+#ifdef _WIN32
+    /// Longest sleep that cannot miss window input: none, input ends the wait.
+    static const int INPUT_WAIT_MS = -1;
+
+    UiWakeup() : event(CreateEvent(NULL, FALSE, FALSE, NULL)) {}
+    ~UiWakeup() { CloseHandle(event); }
+
+    /// Ends the current or the next wait (any thread).
+    void wake() { SetEvent(event); }
+
+    /**
+     * @brief Sleeps until wake(), window input or the timeout (UI thread).
+     * @param timeoutMs Longest sleep, -1 for no limit.
+     */
+    void wait(int timeoutMs) {
+        MsgWaitForMultipleObjectsEx(1, &event, timeoutMs < 0 ? INFINITE : (DWORD)timeoutMs, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+    }
+
+private:
+    HANDLE event;
+#else
+    /// Longest sleep that cannot miss window input for long.
+    static const int INPUT_WAIT_MS = 5;
+
+    UiWakeup() : signaled(false) {}
+
+    /// Ends the current or the next wait (any thread).
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            signaled = true;
+        }
+        ready.notify_one();
+    }
+
+    /**
+     * @brief Sleeps until wake() or the timeout (UI thread).
+     * @param timeoutMs Longest sleep, -1 for no limit.
+     */
+    void wait(int timeoutMs) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (timeoutMs < 0) {
+            ready.wait(lock, [this] { return signaled; });
+        } else {
+            ready.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return signaled; });
+        }
+        signaled = false;
+    }
+
+private:
+    bool signaled;  ///< wake() since the last wait; mutex.
+    std::mutex mutex;
+    std::condition_variable ready;
+#endif
+};
+
+#endif // UI_WAKEUP_H
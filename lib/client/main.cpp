@@ -4,9 +4,16 @@
  */
 
 #include <SFML/Graphics.hpp>
-#include <iostream>
-#include <windows.h> // Для роботи з серійним портом на Windows
 #include "D:/simpleini-master/simpleini-master/SimpleIni.h"
+#include "ConfigStore.h"
+#include "GameLog.h"
+#include "GameScene.h"
+#include "LatencyTrace.h"
+#include "Log.h"
+#include "MovePredictor.h"
+#include "SerialWorker.h"
+#include "SettingsView.h"
+#include "UiWakeup.h"
 /// Size of the game board (3x3).
 const int SIZE_BOARD = 3;
 /// Size of each tile in pixels.
@@ -15,63 +22,41 @@ const int TILE_SIZE = 100;
 char board[SIZE_BOARD][SIZE_BOARD] = { {' ', ' ', ' '}, {' ', ' ', ' '}, {' ', ' ', ' '} }; 
 
 
-HANDLE hSerial; ///< Handle for the serial port.
-DCB dcbSerialParams = { 0 }; ///< Serial port configuration parameters.
-COMMTIMEOUTS timeouts = { 0 }; ///< Serial port timeouts configuration.
+#ifdef _WIN32
+const char* const DEFAULT_SERIAL_PORT = "COM7"; ///< Port used when config.ini names none.
+#else
+const char* const DEFAULT_SERIAL_PORT = "/dev/ttyACM0"; ///< Port used when config.ini names none.
+#endif
+
+PlatformSerialPort serialPort; ///< Serial port to the Arduino.
+std::string serialPortName = DEFAULT_SERIAL_PORT; ///< Device name from config.ini.
+unsigned long serialBaud = 9600; ///< Baud rate from config.ini; the firmware starts at 9600.
+unsigned long serialMaxBaud = 1000000; ///< [Serial] MaxBaud: fastest rate to negotiate, 0 keeps Baud.
+bool binaryProtocol = false; ///< Ask the Arduino for binary frames (see Protocol.h).
+SerialWorker serialWorker; ///< Serial I/O thread; the UI only talks to its queues.
+UiWakeup uiWakeup; ///< Ends the UI thread's idle wait when a reply arrives.
+/// Settings and statistics file.
+const char* const CONFIG_PATH = "D:/scad/csad2425Ki401HerbeiOleksandr03/config/config.ini";
+ConfigStore configStore; ///< config.ini in memory; writes go through its journal thread.
+/// Binary log of every finished game (read it with lib/host/game_stats).
+const char* const GAME_LOG_PATH = "D:/scad/csad2425Ki401HerbeiOleksandr03/config/games.log";
+GameLog gameLog; ///< Appends finished games on its own thread.
+LatencyTrace latencyTrace; ///< Round-trip latency of every command, by stage.
+std::string logFilePath; ///< [Log] File from config.ini; empty logs to the console.
+std::string traceCsvPath; ///< [Trace] Csv from config.ini; empty writes no trace.
+bool showLatencyHud = false; ///< Latency overlay on (F3 toggles it).
+bool predictMoves = true; ///< Draw the predicted AI reply before the Arduino answers.
+MovePredictor movePredictor; ///< Pending prediction and its hit counters.
+uint8_t aiTier = TIER_NORMAL; ///< [Game] Tier from config.ini: AiTier of the games started next.
 
 /**
  * @brief Opens the serial port with specified configurations.
- * @param portName Name of the serial port (e.g., "COM7").
+ * @param portName Name of the serial port (e.g., "COM7" or "/dev/ttyACM0").
  * @return True if the port is opened successfully, false otherwise.
  */
 
 bool openSerialPort(const char* portName) {
-    hSerial = CreateFileA(portName, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    if (hSerial == INVALID_HANDLE_VALUE) {
-        return false;
-    }
-
-    dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
-    if (!GetCommState(hSerial, &dcbSerialParams)) {
-        return false;
-    }
-
-    dcbSerialParams.BaudRate = CBR_4800;
-    dcbSerialParams.ByteSize = 8;
-    dcbSerialParams.StopBits = ONESTOPBIT;
-    dcbSerialParams.Parity = NOPARITY;
-    if (!SetCommState(hSerial, &dcbSerialParams)) {
-        return false;
-    }
-
-    timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
-    timeouts.ReadTotalTimeoutMultiplier = 10;
-    timeouts.WriteTotalTimeoutConstant = 50;
-    timeouts.WriteTotalTimeoutMultiplier = 10;
-    if (!SetCommTimeouts(hSerial, &timeouts)) {
-        return false;
-    }
-
-    return true;
-}
-
-/**
- * @brief Updates the game board based on the response received from the Arduino.
- * @param response Response received from the Arduino.
- */
-
-void updateBoardFromSerial(const std::string& response) {
-    if (response.length() < SIZE_BOARD * SIZE_BOARD) {
-        return; 
-    }
-
-    int index = 0;
-    for (int i = 0; i < SIZE_BOARD; ++i) {
-        for (int j = 0; j < SIZE_BOARD; ++j) {
-            board[i][j] = response[index++];
-        }
-    }
+    return serialPort.open(portName, serialBaud);
 }
 
 /**
@@ -100,212 +85,162 @@ struct Stats {
 Stats stats; ///< Game statistics.
 
 /**
- * @brief Saves the game statistics to an existing INI file.
- * @param filename Name of the INI file.
+ * @brief Saves the game statistics to the config store.
+ *
+ * Only changed values are queued; the store appends them to its journal on
+ * its own thread, so this never touches the disk on the UI thread.
  */
 
-void saveStatsToExistingINI(const std::string& filename) {
-    CSimpleIniA ini;
-    ini.SetUnicode();
-
-
-    if (ini.LoadFile(filename.c_str()) != SI_OK) {
-        std::cout << "Failed to load INI file." << std::endl;
-        return;
-    }
-
-    ini.SetLongValue("Stats_PvP", "Games", stats.pvpGames);
-    ini.SetLongValue("Stats_PvP", "WinsX", stats.winsX);
-    ini.SetLongValue("Stats_PvP", "LossesX", stats.lossesX);
-    ini.SetLongValue("Stats_PvP", "DrawsX", stats.drawsX);
-    ini.SetLongValue("Stats_PvP", "WinsO", stats.winsO);
-    ini.SetLongValue("Stats_PvP", "LossesO", stats.lossesO);
-    ini.SetLongValue("Stats_PvP", "DrawsO", stats.drawsO);
-
-    ini.SetLongValue("Stats ", "Games", stats.Games);
-    ini.SetLongValue("Stats ", "Wins", stats.Wins);
-    ini.SetLongValue("Stats ", "Draws", stats.Draws);
-    ini.SetLongValue("Stats ", "Losses", stats.Losses);
-    ini.SetLongValue("Stats ", "Winrate", stats.Winrate);
-
-    if (ini.SaveFile(filename.c_str()) != SI_OK) {
-        std::cout << "Failed to save INI file." << std::endl;
-    }
-    else {
-        std::cout << "Stats saved to existing INI file successfully." << std::endl;
-    }
+void saveStatsToExistingINI() {
+    configStore.setLong("Stats_PvP", "Games", stats.pvpGames);
+    configStore.setLong("Stats_PvP", "WinsX", stats.winsX);
+    configStore.setLong("Stats_PvP", "LossesX", stats.lossesX);
+    configStore.setLong("Stats_PvP", "DrawsX", stats.drawsX);
+    configStore.setLong("Stats_PvP", "WinsO", stats.winsO);
+    configStore.setLong("Stats_PvP", "LossesO", stats.lossesO);
+    configStore.setLong("Stats_PvP", "DrawsO", stats.drawsO);
+
+    configStore.setLong("Stats ", "Games", stats.Games);
+    configStore.setLong("Stats ", "Wins", stats.Wins);
+    configStore.setLong("Stats ", "Draws", stats.Draws);
+    configStore.setLong("Stats ", "Losses", stats.Losses);
+    configStore.setLong("Stats ", "Winrate", stats.Winrate);
 }
 
 /**
- * @brief Loads the game statistics from an existing INI file.
- * @param filename Name of the INI file.
+ * @brief Loads the game statistics from the config store.
  */
 
-void loadStatsFromExistingINI(const std::string& filename) {
-    CSimpleIniA ini;
-    ini.SetUnicode();
-
-    if (ini.LoadFile(filename.c_str()) != SI_OK) {
-        std::cout << "Failed to load INI file." << std::endl;
-        return;
-    }
-
-    stats.pvpGames = ini.GetLongValue("Stats_PvP", "Games", 0);
-    stats.winsX = ini.GetLongValue("Stats_PvP", "WinsX", 0);
-    stats.lossesX = ini.GetLongValue("Stats_PvP", "LossesX", 0);
-    stats.drawsX = ini.GetLongValue("Stats_PvP", "DrawsX", 0);
-    stats.winsO = ini.GetLongValue("Stats_PvP", "WinsO", 0);
-    stats.lossesO = ini.GetLongValue("Stats_PvP", "LossesO", 0);
-    stats.drawsO = ini.GetLongValue("Stats_PvP", "DrawsO", 0);
+void loadStatsFromExistingINI() {
+    stats.pvpGames = configStore.getLong("Stats_PvP", "Games", 0);
+    stats.winsX = configStore.getLong("Stats_PvP", "WinsX", 0);
+    stats.lossesX = configStore.getLong("Stats_PvP", "LossesX", 0);
+    stats.drawsX = configStore.getLong("Stats_PvP", "DrawsX", 0);
+    stats.winsO = configStore.getLong("Stats_PvP", "WinsO", 0);
+    stats.lossesO = configStore.getLong("Stats_PvP", "LossesO", 0);
+    stats.drawsO = configStore.getLong("Stats_PvP", "DrawsO", 0);
 
 
-    stats.Games = ini.GetLongValue("Stats ", "Games", 0);
-    stats.Wins = ini.GetLongValue("Stats ", "Wins", 0);
-    stats.Draws = ini.GetLongValue("Stats ", "Draws", 0);
-    stats.Losses = ini.GetLongValue("Stats ", "Losses", 0);
-    stats.Winrate = ini.GetLongValue("Stats ", "Winrate", 0);
+    stats.Games = configStore.getLong("Stats ", "Games", 0);
+    stats.Wins = configStore.getLong("Stats ", "Wins", 0);
+    stats.Draws = configStore.getLong("Stats ", "Draws", 0);
+    stats.Losses = configStore.getLong("Stats ", "Losses", 0);
+    stats.Winrate = configStore.getLong("Stats ", "Winrate", 0);
 
 
-    std::cout << "Stats loaded from existing INI file successfully." << std::endl;
+    logMessage(LOG_INFO, "Stats loaded from existing INI file successfully.");
 }
 
 /**
- * @brief Loads the configuration from an INI file.
- * @param filename Name of the INI file.
+ * @brief Loads the configuration from the config store.
  * @param blueLedState State of the blue LED.
  * @param yellowLedState State of the yellow LED.
  */
 
-void loadConfig(const std::string& filename, bool& blueLedState, bool& yellowLedState) {
-    CSimpleIniA ini;
-    ini.SetUnicode();
-    if (ini.LoadFile(filename.c_str()) != SI_OK) {
-        std::cout << "Failed to load INI file." << std::endl;
-        return;
-    }
-
-    blueLedState = ini.GetBoolValue("LEDs", "Blue", false);
-    yellowLedState = ini.GetBoolValue("LEDs", "Yellow", false);
-
-    std::cout << "Blue LED: " << (blueLedState ? "ON" : "OFF") << std::endl;
-    std::cout << "Yellow LED: " << (yellowLedState ? "ON" : "OFF") << std::endl;
+void loadConfig(bool& blueLedState, bool& yellowLedState) {
+    blueLedState = configStore.getBool("LEDs", "Blue", false);
+    yellowLedState = configStore.getBool("LEDs", "Yellow", false);
+    binaryProtocol = configStore.getBool("Serial", "Binary", false);
+    serialPortName = configStore.getString("Serial", "Port", DEFAULT_SERIAL_PORT);
+    serialBaud = (unsigned long)configStore.getLong("Serial", "Baud", 9600);
+    serialMaxBaud = (unsigned long)configStore.getLong("Serial", "MaxBaud", 1000000);
+
+    logSink().setLevel(parseLogLevel(configStore.getString("Log", "Level", "info"), LOG_INFO));
+    logFilePath = configStore.getString("Log", "File", "");
+    traceCsvPath = configStore.getString("Trace", "Csv", "");
+    showLatencyHud = configStore.getBool("Trace", "Hud", false);
+    predictMoves = configStore.getBool("Serial", "Predict", true);
+    long tier = configStore.getLong("Game", "Tier", TIER_NORMAL);
+    aiTier = tier >= 0 && tier < AI_TIER_COUNT ? (uint8_t)tier : (uint8_t)TIER_NORMAL;
+
+    logMessage(LOG_INFO, "Blue LED: %s", blueLedState ? "ON" : "OFF");
+    logMessage(LOG_INFO, "Yellow LED: %s", yellowLedState ? "ON" : "OFF");
 }
 
 /**
- * @brief Saves LED configuration to an INI file.
- * @param filename Path to the INI file.
+ * @brief Saves LED configuration to the config store.
  * @param blueLedState Current state of the blue LED.
  * @param yellowLedState Current state of the yellow LED.
  */
 
-void saveConfig(const std::string& filename, bool& blueLedState, bool& yellowLedState) {
-    CSimpleIniA ini;
-    ini.SetUnicode();
-    if (ini.LoadFile(filename.c_str()) != SI_OK) {
-        std::cout << "Failed to load INI file." << std::endl;
-        return;
-    }
-
-    ini.SetBoolValue("LEDs", "Blue", blueLedState);
-    ini.SetBoolValue("LEDs", "Yellow", yellowLedState);
-
-    if (ini.SaveFile(filename.c_str()) != SI_OK) {
-        std::cout << "Failed to save INI file." << std::endl; 
-    }
-    else {
-        std::cout << "Configuration saved successfully." << std::endl; 
-    }
+void saveConfig(bool& blueLedState, bool& yellowLedState) {
+    configStore.setBool("LEDs", "Blue", blueLedState);
+    configStore.setBool("LEDs", "Yellow", yellowLedState);
 }
 
 /**
  * @brief Clears the serial buffer by reading all available data.
  */
 void clearSerialBuffer() {
-    char buffer[256];
-    DWORD bytes_read;
-    while (ReadFile(hSerial, buffer, sizeof(buffer), &bytes_read, NULL) && bytes_read > 0) {}
+    uint8_t buffer[256];
+    while (serialPort.read(buffer, sizeof(buffer), 0) > 0) {}
 }
 
 
 /**
- * @brief Writes data to the serial port.
- * @param data String to send to the Arduino.
+ * @brief Queues a command for the serial thread.
+ * @param opcode OP_RESET, OP_MODE, OP_MOVE or OP_LED.
+ * @param value GameMode, cell index (row * 3 + col) or LED (0 blue, 1 yellow).
+ * @param tier OP_MODE: AiTier of the new game.
  */
-void writeSerialPort(const std::string& data) {
-
-    DWORD bytes_written;
-    if (WriteFile(hSerial, data.c_str(), data.size(), &bytes_written, NULL)) {
-        std::cout << "[Frontend] Sent to Arduino: " << data << std::endl; 
+void sendCommand(uint8_t opcode, uint8_t value, uint8_t tier = TIER_NORMAL) {
+    if (!serialWorker.send(opcode, value, tier)) {
+        logMessage(LOG_WARN, "[Frontend] Command queue full, command dropped");
     }
-    else {
-        std::cout << "[Frontend] Error sending to Arduino!" << std::endl; 
-    }
-
 }
 
 /**
- * @brief Reads data from the serial port.
- * @return String received from the Arduino.
+ * @brief Adds a finished game to the statistics.
+ * @param status Game status reported by the Arduino.
+ * @return True if the game is over.
  */
-
-std::string readSerialPort() {
-    char buffer[256] = { 0 };
-    DWORD bytes_read;
-    if (ReadFile(hSerial, buffer, sizeof(buffer) - 1, &bytes_read, NULL)) {
-        buffer[bytes_read] = '\0'; 
-        std::cout << "[Backend] Received from Arduino: " << buffer << std::endl; 
-        return std::string(buffer);
-
-    }
-    std::cout << "[Frontend] Error reading from Arduino!" << std::endl;
-    return ""; 
-}
-
-/**
- * @brief Draws the Tic-Tac-Toe board grid.
- * @param window Reference to the SFML window.
- */
-void drawBoard(sf::RenderWindow& window) {
-    for (int i = 0; i <= SIZE_BOARD; ++i) {
-        
-        sf::RectangleShape horizontalLine(sf::Vector2f(TILE_SIZE * SIZE_BOARD, 5));
-        horizontalLine.setPosition(0, i * TILE_SIZE);
-        horizontalLine.setFillColor(sf::Color::Black);
-        window.draw(horizontalLine);
-
-        sf::RectangleShape verticalLine(sf::Vector2f(5, TILE_SIZE * SIZE_BOARD));
-        verticalLine.setPosition(i * TILE_SIZE - 4, 0); 
-        verticalLine.setFillColor(sf::Color::Black);
-        window.draw(verticalLine);
+bool recordResult(int status) {
+    switch (status) {
+    case STATUS_X_WIN:
+        stats.winsX++;
+        stats.lossesO++;
+        stats.pvpGames++;
+        break;
+    case STATUS_O_WIN:
+        stats.winsO++;
+        stats.lossesX++;
+        stats.pvpGames++;
+        break;
+    case STATUS_AI_WIN:
+        stats.Losses++;
+        stats.Games++;
+        stats.Winrate = stats.Wins * 100 / stats.Games;
+        break;
+    case STATUS_PLAYER_WIN:
+        stats.Wins++;
+        stats.Games++;
+        stats.Winrate = stats.Wins * 100 / stats.Games;
+        break;
+    case STATUS_DRAW:
+        stats.drawsX++;
+        stats.drawsO++;
+        stats.Draws++;
+        stats.Games++;
+        break;
+    default:
+        return false;
     }
+    return true;
 }
 
-
 /**
- * @brief Draws X and O marks on the game board.
- * @param window Reference to the SFML window.
- * @param font Font used for the marks.
+ * @brief Formats the latency HUD: the link rate and errors, the stage percentiles and the prediction counters.
  */
-void drawMarks(sf::RenderWindow& window, sf::Font& font) {
-    for (int i = 0; i < SIZE_BOARD; ++i) {
-        for (int j = 0; j < SIZE_BOARD; ++j) {
-            if (board[i][j] != ' ') {
-                sf::Text text;
-                text.setFont(font);
-                text.setString(board[i][j]);
-                text.setCharacterSize(100);
-                text.setPosition(j * TILE_SIZE + 15, i * TILE_SIZE - 20);
-                text.setFillColor(sf::Color::Black);
-                window.draw(text);
-            }
-        }
-    }
+std::string hudText() {
+    return serialWorker.linkSummary() + latencyTrace.summary() + movePredictor.summary();
 }
 
 /**
  * @brief Resets the game board to its initial state.
+ * A pending prediction is dropped; the reply to its move is no longer compared.
  */
 void resetBoard() {
+    movePredictor.cancel();
     for (int i = 0; i < SIZE_BOARD; ++i) {
         for (int j = 0; j < SIZE_BOARD; ++j) {
             board[i][j] = ' '; 
@@ -313,130 +248,6 @@ void resetBoard() {
     }
 }
 
-/**
- * @brief Draws the game interface including board, marks, and buttons.
- * @param window Reference to the SFML window.
- * @param font Font used for button texts.
- * @param playerFirstButton Rectangle shape for the "Player First" button.
- * @param playerFirstText Text displayed on the "Player First" button.
- * @param aiFirstButton Rectangle shape for the "AI First" button.
- * @param aiFirstText Text displayed on the "AI First" button.
- * @param restartButton Rectangle shape for the "Restart" button.
- * @param restartText Text displayed on the "Restart" button.
- * @param pvpButton Rectangle shape for the "PvP" button.
- * @param pvpText Text displayed on the "PvP" button.
- * @param settingsButton Rectangle shape for the "Settings" button.
- * @param settingsText Text displayed on the "Settings" button.
- */
-void drawGame(sf::RenderWindow& window, sf::Font& font, sf::RectangleShape playerFirstButton, sf::Text playerFirstText, sf::RectangleShape aiFirstButton, sf::Text aiFirstText, sf::RectangleShape restartButton, sf::Text restartText, sf::RectangleShape pvpButton, sf::Text pvpText, sf::RectangleShape settingsButton, sf::Text settingsText) {
-	window.clear(sf::Color::White);   
-	drawBoard(window);                
-	drawMarks(window, font);          
-    window.draw(playerFirstButton);   
-    window.draw(playerFirstText);    
-    window.draw(aiFirstButton);      
-    window.draw(aiFirstText);       
-    window.draw(restartButton);    
-    window.draw(restartText);     
-    window.draw(pvpButton);   
-    window.draw(pvpText);      
-    window.draw(settingsButton); 
-    window.draw(settingsText);
-    window.display();
-
-}
-
-/**
- * @brief Draws the game interface including board, marks, and buttons.
- * @param window Reference to the SFML window.
- * @param font Font used for button texts.
- * @param playerFirstButton Rectangle shape for the "Player First" button.
- * @param playerFirstText Text displayed on the "Player First" button.
- * @param aiFirstButton Rectangle shape for the "AI First" button.
- * @param aiFirstText Text displayed on the "AI First" button.
- * @param restartButton Rectangle shape for the "Restart" button.
- * @param restartText Text displayed on the "Restart" button.
- * @param pvpButton Rectangle shape for the "PvP" button.
- * @param pvpText Text displayed on the "PvP" button.
- * @param settingsButton Rectangle shape for the "Settings" button.
- * @param settingsText Text displayed on the "Settings" button.
- */
-void drawSettingsMenu(sf::RenderWindow& settingsWindow, sf::Font& font, sf::RectangleShape& blueLedButton, sf::Text& blueLedText, sf::RectangleShape& yellowLedButton, sf::Text& yellowLedText) {
-    settingsWindow.clear(sf::Color::White);
-
-   
-    settingsWindow.draw(blueLedButton);
-    settingsWindow.draw(blueLedText);
-
-    settingsWindow.draw(yellowLedButton);
-    settingsWindow.draw(yellowLedText);
-
-    settingsWindow.display();
-}
-
-/**
- * @brief Opens the settings menu for controlling LED states.
- * @param font Font used for the settings menu.
- * @param blueLedState Reference to the state of the blue LED.
- * @param yellowLedState Reference to the state of the yellow LED.
- */
-void openSettingsMenu(sf::Font& font, bool& blueLedState, bool& yellowLedState) {
-    sf::RenderWindow settingsWindow(sf::VideoMode(400, 300), "Settings");
-
-    sf::RectangleShape blueLedButton(sf::Vector2f(200, 50));
-    blueLedButton.setPosition(100, 50);
-    blueLedButton.setFillColor(sf::Color::Blue);
-
-    sf::Text blueLedText;
-    blueLedText.setFont(font);
-    blueLedText.setCharacterSize(20);
-    blueLedText.setFillColor(sf::Color::White);
-
-    sf::RectangleShape yellowLedButton(sf::Vector2f(200, 50));
-    yellowLedButton.setPosition(100, 150);
-    yellowLedButton.setFillColor(sf::Color::Yellow);
-
-    sf::Text yellowLedText;
-    yellowLedText.setFont(font);
-    yellowLedText.setCharacterSize(20);
-    yellowLedText.setFillColor(sf::Color::Black);
-
-    while (settingsWindow.isOpen()) {
-        sf::Event event;
-        while (settingsWindow.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                settingsWindow.close();
-            }
-
-            if (event.type == sf::Event::MouseButtonPressed) {
-                int mouseX = event.mouseButton.x;
-                int mouseY = event.mouseButton.y;
-
-                if (blueLedButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    blueLedState = !blueLedState; 
-                    saveConfig("D:/scad/csad2425Ki401HerbeiOleksandr03/config/config.ini", blueLedState, yellowLedState);
-                    writeSerialPort("BLed\n");
-                }
-                else if (yellowLedButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    yellowLedState = !yellowLedState; 
-                    saveConfig("D:/scad/csad2425Ki401HerbeiOleksandr03/config/config.ini", blueLedState, yellowLedState);
-                    writeSerialPort("Yled\n");
-                }
-            }
-        }
-
-        blueLedText.setString(blueLedState ? "Blue LED: ON" : "Blue LED: OFF");
-        blueLedText.setPosition(blueLedButton.getPosition().x + 20, blueLedButton.getPosition().y + 10);
-
-        yellowLedText.setString(yellowLedState ? "Yellow LED: ON" : "Yellow LED: OFF");
-        yellowLedText.setPosition(yellowLedButton.getPosition().x + 20, yellowLedButton.getPosition().y + 10);
-
-        drawSettingsMenu(settingsWindow, font, blueLedButton, blueLedText, yellowLedButton, yellowLedText);
-    }
-}
-
-
-
 /**
  * @brief Main function for the Tic-Tac-Toe game.
  * Initializes the game window, serial communication, and event handling.
@@ -449,17 +260,34 @@ int main() {
         return 1;
     }
 
-    if (!openSerialPort("COM7")) {
-        return 1;
-    }
-
     bool blueLedState;
     bool yellowLedState;
 
     bool gameOver = false;
     bool resetRequested = false; 
-    loadConfig("D:/scad/csad2425Ki401HerbeiOleksandr03/config/config.ini", blueLedState, yellowLedState);
-    loadStatsFromExistingINI("D:/scad/csad2425Ki401HerbeiOleksandr03/config/config.ini");
+    bool waitingForReply = false; ///< A move was sent and its reply has not arrived yet.
+    uint8_t currentMode = MODE_PLAYER; ///< Mode of the game the next board belongs to.
+    uint8_t currentTier = TIER_NORMAL; ///< AiTier of that game; the firmware keeps it over resets.
+    GameRecorder recorder; ///< Moves and timing of the running game.
+    configStore.open(CONFIG_PATH);
+    loadConfig(blueLedState, yellowLedState);
+    if (!logFilePath.empty() && !logSink().open(logFilePath.c_str())) {
+        logMessage(LOG_ERROR, "Failed to open the log file %s", logFilePath.c_str());
+    }
+    logSink().start();
+    loadStatsFromExistingINI();
+    if (!gameLog.open(GAME_LOG_PATH)) {
+        logMessage(LOG_ERROR, "Failed to open the game log.");
+    }
+    if (!traceCsvPath.empty() && !latencyTrace.openCsv(traceCsvPath.c_str())) {
+        logMessage(LOG_ERROR, "Failed to open the latency trace %s", traceCsvPath.c_str());
+    }
+    if (!openSerialPort(serialPortName.c_str())) {
+        return 1;
+    }
+    serialWorker.setWakeup(&uiWakeup);
+    serialWorker.setLinkRates(serialBaud, serialMaxBaud);
+    serialWorker.start(serialPort, binaryProtocol);
 
     sf::RectangleShape playerFirstButton(sf::Vector2f(150, 50));
     playerFirstButton.setPosition((TILE_SIZE * SIZE_BOARD - 300) / 2, TILE_SIZE * SIZE_BOARD + 20);
@@ -511,10 +339,19 @@ int main() {
     settingsText.setFillColor(sf::Color::Black);
     settingsText.setPosition(settingsButton.getPosition().x + 10, settingsButton.getPosition().y + 10);
             
-    // Initialization of game buttons and their positions...
-    // (This section is already documented in function parameters above.)
-    drawGame(window,font, playerFirstButton, playerFirstText, aiFirstButton, aiFirstText, restartButton, restartText, pvpButton, pvpText, settingsButton, settingsText);
-    
+    GameScene scene(font, SIZE_BOARD, TILE_SIZE);
+    scene.addButton(playerFirstButton, playerFirstText);
+    scene.addButton(aiFirstButton, aiFirstText);
+    scene.addButton(restartButton, restartText);
+    scene.addButton(pvpButton, pvpText);
+    scene.addButton(settingsButton, settingsText);
+    if (showLatencyHud) {
+        scene.setOverlay(hudText());
+    }
+    SettingsView settings(font, TILE_SIZE * SIZE_BOARD);
+    settings.setLeds(blueLedState, yellowLedState);
+    settings.setTier(AI_TIER_NAMES[aiTier]);
+    bool settingsOpen = false; ///< The settings view is shown instead of the game.
 
 
     while (window.isOpen()) {
@@ -523,98 +360,165 @@ int main() {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+                scene.invalidate();
+                settings.invalidate();
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                showLatencyHud = !showLatencyHud;
+                configStore.setBool("Trace", "Hud", showLatencyHud);
+                scene.setOverlay(showLatencyHud ? hudText() : "");
+            }
+
+            if (settingsOpen) {
+                SettingsView::Action action = SettingsView::NONE;
+                if (event.type == sf::Event::MouseButtonPressed) {
+                    action = settings.click(event.mouseButton.x, event.mouseButton.y);
+                }
+                else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+                    action = SettingsView::BACK;
+                }
+                if (action == SettingsView::BLUE || action == SettingsView::YELLOW) {
+                    bool& state = action == SettingsView::BLUE ? blueLedState : yellowLedState;
+                    state = !state;
+                    saveConfig(blueLedState, yellowLedState);
+                    sendCommand(OP_LED, action == SettingsView::BLUE ? 0 : 1);
+                    settings.setLeds(blueLedState, yellowLedState);
+                }
+                else if (action == SettingsView::TIER) {
+                    aiTier = (aiTier + 1) % AI_TIER_COUNT;
+                    configStore.setLong("Game", "Tier", aiTier);
+                    settings.setTier(AI_TIER_NAMES[aiTier]);
+                }
+                else if (action == SettingsView::BACK) {
+                    settingsOpen = false;
+                    scene.invalidate();
+                }
+                continue;
+            }
 
             if (event.type == sf::Event::MouseButtonPressed) {
                 int mouseX = event.mouseButton.x;
                 int mouseY = event.mouseButton.y;
 
                 if (restartButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    writeSerialPort("reset\n");
+                    sendCommand(OP_RESET, 0);
+                    movePredictor.cancel();
+                    currentMode = MODE_PLAYER; // the firmware resets to a game against the AI
                     resetRequested = true; 
                 }
                 else if (playerFirstButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    writeSerialPort("player\n");
+                    sendCommand(OP_MODE, MODE_PLAYER, aiTier);
+                    currentMode = MODE_PLAYER;
+                    currentTier = aiTier;
                     resetBoard(); 
                     resetRequested = true; 
                 }
                 else if (aiFirstButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    writeSerialPort("ai\n");
+                    sendCommand(OP_MODE, MODE_AI, aiTier);
+                    currentMode = MODE_AI;
+                    currentTier = aiTier;
                     resetBoard(); 
                     resetRequested = true; 
                 }
                 else if (settingsButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    openSettingsMenu(font, yellowLedState, blueLedState);
+                    settingsOpen = true;
+                    settings.invalidate();
                 }
                 else if (pvpButton.getGlobalBounds().contains(mouseX, mouseY)) {
-                    writeSerialPort("pvp\n");
+                    sendCommand(OP_MODE, MODE_PVP, aiTier);
+                    currentMode = MODE_PVP;
+                    currentTier = aiTier;
                     resetBoard(); 
                     resetRequested = true; 
                 }
-                else if (!gameOver && !resetRequested) { 
+                else if (!gameOver && !resetRequested && !waitingForReply) { 
                     int row = mouseY / TILE_SIZE;
                     int col = mouseX / TILE_SIZE;
 
                     if (row < SIZE_BOARD && col < SIZE_BOARD && board[row][col] == ' ') {
-                        std::string move = std::to_string(row) + "," + std::to_string(col) + "\n";
-                        writeSerialPort(move);
-                        
-                        std::string response = readSerialPort();
-                        updateBoardFromSerial(response);
-
-                        if (response.find("X win!") != std::string::npos) {
-                            stats.winsX++;
-                            stats.lossesO++;
-                            stats.pvpGames++;
-                            
-                            gameOver = true;
-                        }
-                        else if (response.find("O win!") != std::string::npos) {
-                            stats.winsO++;
-                            stats.lossesX++;
-                            stats.pvpGames++;
-                            gameOver = true;
-                        }
-                        else if (response.find("AI win!") != std::string::npos) {
-                            stats.Losses++;
-                            stats.Games++;
-                            stats.Winrate = (stats.Wins / stats.Games) * 100;
-                            gameOver = true;
-                        }
-                        else if (response.find("You win!") != std::string::npos) {
-                            stats.Wins++;
-                            stats.Games++;
-                            stats.Winrate = (stats.Wins / stats.Games) * 100;
-                            gameOver = true;
-                        }
-                        else if (response.find("Draw!") != std::string::npos) {
-                            stats.drawsX++;
-                            stats.drawsO++;
-                            stats.Draws++;
-                            stats.Games++;
-                            gameOver = true;
-                        }
-                        if (gameOver) {
-                            saveStatsToExistingINI("D:/scad/csad2425Ki401HerbeiOleksandr03/config/config.ini");
+                        sendCommand(OP_MOVE, row * SIZE_BOARD + col);
+                        recorder.moveSent(row * SIZE_BOARD + col);
+                        if (predictMoves && (currentMode == MODE_PVP || MovePredictor::predictable(currentTier))) {
+                            movePredictor.predict(&board[0][0], row * SIZE_BOARD + col, currentMode != MODE_PVP);
                         }
+                        waitingForReply = true;
+                    }
+                }
+            }
+        }
 
-                        drawGame(window, font, playerFirstButton, playerFirstText, aiFirstButton, aiFirstText, restartButton, restartText, pvpButton, pvpText, settingsButton, settingsText);
+        SerialMessage message;
+        while (serialWorker.poll(message)) {
+            int status = STATUS_PLAYING;
+            bool mispredicted = false;
+            switch (message.kind) {
+            case SerialMessage::BOARD:
+                memcpy(board, message.cells, sizeof(message.cells));
+                if (resetRequested) {
+                    resetRequested = false; 
+                    gameOver = false;   
+                    recorder.begin(currentMode);
+                }
+                mispredicted = movePredictor.reconcile(&board[0][0]);
+                recorder.observe(&board[0][0]);
+                break;
+            case SerialMessage::DELTA:
+                movePredictor.rollback(&board[0][0]);
+                for (int m = 0; m < 2; m++) {
+                    uint8_t delta = message.delta[m];
+                    if (delta != NO_DELTA) {
+                        board[(delta & 0x0F) / SIZE_BOARD][(delta & 0x0F) % SIZE_BOARD] = (delta >> 4) == 1 ? 'X' : 'O';
                     }
                 }
+                mispredicted = movePredictor.reconcile(&board[0][0]);
+                recorder.observe(&board[0][0]);
+                status = message.status;
+                break;
+            case SerialMessage::STATUS:
+                status = message.status;
+                break;
+            case SerialMessage::NACK:
+                movePredictor.rollback(&board[0][0]);
+                mispredicted = movePredictor.reconcile(&board[0][0]);
+                break;
+            }
+            if (mispredicted) {
+                logMessage(LOG_INFO, "[Frontend] Mispredicted the reply, board rolled back (%lu of %lu)",
+                    movePredictor.missed(), movePredictor.settled());
+            }
+            if (message.kind != SerialMessage::STATUS) {
+                waitingForReply = false;
+            }
+            if (latencyTrace.record(message.trace, TraceClock::now()) && showLatencyHud) {
+                scene.setOverlay(hudText());
+            }
+            if (!gameOver && recordResult(status)) {
+                gameOver = true;
+                saveStatsToExistingINI();
+                if (recorder.running()) {
+                    gameLog.append(recorder.finish(status));
+                }
             }
         }
 
-        if (resetRequested) {
-            std::string response = readSerialPort();
-            if (!response.empty()) {
-                updateBoardFromSerial(response);
-                resetRequested = false; 
-                gameOver = false;   
-                drawGame(window, font, playerFirstButton, playerFirstText, aiFirstButton, aiFirstText, restartButton, restartText, pvpButton, pvpText, settingsButton, settingsText);
+        if (window.isOpen()) {
+            scene.setBoard(&board[0][0]);
+            if (settingsOpen) {
+                settings.present(window);
+            } else {
+                scene.present(window);
             }
+            // Nothing to draw until the next input or reply: sleep until one arrives.
+            uiWakeup.wait(UiWakeup::INPUT_WAIT_MS);
         }
     }
 
-
-    CloseHandle(hSerial); 
+    serialWorker.stop();
+    serialPort.close(); 
+    configStore.close();
+    gameLog.close();
+    latencyTrace.closeCsv();
+    logSink().stop();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,642 @@
+/**
+ * @file Gateway.h
+ * @brief epoll gateway that serves the firmware's text protocol to many network clients (Linux).
+ *
+ * Clients connect over TCP or a Unix socket and speak the same commands the
+ * board takes on its serial port ("player", "ai", "pvp", "reset", "r,c"),
+ * one per line; they get the same board and result lines back. Every client
+ * plays its own game on a GameBackend:
+ *   - the in-process engine (lib/host/gateway.cpp) runs the firmware logic
+ *     of task3.ino on the client's packed game, with no limit on games;
+ *   - SerialBackend multiplexes the clients onto one board through the
+ *     firmware's "@<id>" sessions (see Sessions.h), one session per client.
+ *
+ * The event loop is edge-triggered. Each client has its own backpressure: it
+ * is not read while OUTPUT_HIGH_WATER bytes of replies wait for it (until
+ * they drain below OUTPUT_LOW_WATER) or while its backend queue is full, so
+ * a slow or flooding client only ever holds a bounded amount of memory and
+ * never delays the others.
+ */
+#ifndef GATEWAY_H
+#define GATEWAY_H
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include "BitBoard.h"
+#include "SerialPort.h"
+#include "Sessions.h"
+
+/// Longest command line accepted, as in the firmware's receivedData.
+const size_t GATEWAY_MAX_LINE = 19;
+
+/// A client is not read while this many reply bytes wait for it...
+const size_t OUTPUT_HIGH_WATER = 16384;
+
+/// ...and is read again once they drained below this.
+const size_t OUTPUT_LOW_WATER = 4096;
+
+/// Commands a client may have waiting for a serial backend.
+const size_t COMMAND_QUEUE_LIMIT = 4;
+
+typedef std::chrono::steady_clock GatewayClock;
+
+/**
+ * @struct SocketAddress
+ * @brief "unix:/path", "host:port" or "port" (localhost).
+ */
+struct SocketAddress {
+    bool unixSocket;
+    std::string path;  ///< Unix socket path.
+    std::string host;  ///< IPv4 address.
+    uint16_t port;
+
+    /// @return False if the text is not an address.
+    bool parse(const char* text) {
+        if (strncmp(text, "unix:", 5) == 0) {
+            unixSocket = true;
+            path = text + 5;
+            return !path.empty() && path.size() < sizeof(sockaddr_un().sun_path);
+        }
+        unixSocket = false;
+        const char* colon = strrchr(text, ':');
+        host = colon != NULL ? std::string(text, colon - text) : "127.0.0.1";
+        long value = strtol(colon != NULL ? colon + 1 : text, NULL, 10);
+        port = (uint16_t)value;
+        in_addr probe;
+        return value > 0 && value < 65536 && inet_pton(AF_INET, host.c_str(), &probe) == 1;
+    }
+
+    /// Fills a sockaddr; returns its length.
+    socklen_t fill(sockaddr_storage& storage) const {
+        memset(&storage, 0, sizeof(storage));
+        if (unixSocket) {
+            sockaddr_un& address = (sockaddr_un&)storage;
+            address.sun_family = AF_UNIX;
+            strcpy(address.sun_path, path.c_str());
+            return sizeof(address);
+        }
+        sockaddr_in& address = (sockaddr_in&)storage;
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, host.c_str(), &address.sin_addr);
+        return sizeof(address);
+    }
+};
+
+/// Puts a descriptor in non-blocking mode.
+inline void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/**
+ * @brief Opens a non-blocking listening socket.
+ * @return The socket, -1 on failure (errno set).
+ */
+inline int listenOn(const SocketAddress& address) {
+    int fd = socket(address.unixSocket ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (address.unixSocket) {
+        unlink(address.path.c_str());
+    } else {
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+    sockaddr_storage storage;
+    socklen_t length = address.fill(storage);
+    if (bind(fd, (sockaddr*)&storage, length) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+/**
+ * @brief Connects to a gateway; the socket is left non-blocking.
+ * @return The socket, -1 on failure.
+ */
+inline int connectTo(const SocketAddress& address) {
+    int fd = socket(address.unixSocket ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_storage storage;
+    socklen_t length = address.fill(storage);
+    if (connect(fd, (sockaddr*)&storage, length) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (!address.unixSocket) {
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+/// @return True for a 9-cell board line of ' ', 'X' and 'O'.
+inline bool isBoardLine(const std::string& line) {
+    return line.size() == 9 && line.find_first_not_of(" XO") == std::string::npos;
+}
+
+/**
+ * @brief Tells whether the firmware treats a game as over.
+ * As in finishMove(): a complete line of either mark, or nine moves.
+ * @param cells 9 row-major cells.
+ */
+inline bool boardFinished(const char* cells) {
+    BitBoard b = {0, 0};
+    for (uint8_t i = 0; i < 9; i++) {
+        if (cells[i] == 'O') b.ai |= (uint16_t)(1 << i);
+        else if (cells[i] == 'X') b.player |= (uint16_t)(1 << i);
+    }
+    return bbEvaluate(b) != 0 || bbEmpty(b) == 0;
+}
+
+/**
+ * @brief Checks a line against the gateway's command set.
+ * @return True for "player", "ai", "pvp", "reset" and "r,c" with r, c in 0..2.
+ */
+inline bool isGameCommand(const std::string& line) {
+    if (line == "player" || line == "ai" || line == "pvp" || line == "reset") return true;
+    return line.size() == 3 && line[1] == ',' && line[0] >= '0' && line[0] <= '2' && line[2] >= '0' && line[2] <= '2';
+}
+
+/**
+ * @struct GatewayClient
+ * @brief One connection.
+ */
+struct GatewayClient {
+    int fd;
+    std::string input;    ///< Bytes received, not handled yet.
+    std::string output;   ///< Replies not written yet.
+    bool readable;        ///< The socket may hold unread bytes (edge-triggered).
+    bool throttled;       ///< Output above the high-water mark, not read until it drains.
+    bool discarding;      ///< Skipping the rest of an overlong line.
+    bool servicing;       ///< Inside Gateway::service(), which must not nest.
+    bool dead;            ///< Closed; freed at the end of the event batch.
+    uint8_t session;      ///< SerialBackend session id.
+    PackedGame game;      ///< Engine backend game.
+
+    explicit GatewayClient(int fd) : fd(fd), readable(true), throttled(false), discarding(false),
+        servicing(false), dead(false), session(0), game() {}
+};
+
+/**
+ * @struct GatewayStats
+ * @brief Counters printed when the gateway stops.
+ */
+struct GatewayStats {
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;     ///< Turned away: backend full.
+    uint64_t peak = 0;         ///< Most clients connected at once.
+    uint64_t commands = 0;     ///< Game commands passed to the backend.
+    uint64_t ignored = 0;      ///< Lines outside the command set.
+    uint64_t throttled = 0;    ///< Times a client stopped being read for backpressure.
+};
+
+class Gateway;
+
+/**
+ * @class GameBackend
+ * @brief Plays the clients' games.
+ */
+class GameBackend {
+public:
+    GameBackend() : gateway(NULL) {}
+    virtual ~GameBackend() {}
+
+    /// @return False if there is no room for another game.
+    virtual bool attach(GatewayClient& client) = 0;
+
+    /// Forgets a client that is going away.
+    virtual void detach(GatewayClient& client) = 0;
+
+    /// Runs or queues one command of the command set.
+    virtual void submit(GatewayClient& client, const std::string& command) = 0;
+
+    /// @return False while the client must not send more commands.
+    virtual bool accepting(const GatewayClient&) const { return true; }
+
+    /// @return Descriptor the gateway watches for the backend, -1 if none.
+    virtual int descriptor() const { return -1; }
+
+    /// Called when descriptor() is readable.
+    virtual void onReadable() {}
+
+    /// Called after every event batch and at least every 100 ms.
+    virtual void tick() {}
+
+    /// Prints backend counters.
+    virtual void report() const {}
+
+    Gateway* gateway; ///< Set by the Gateway.
+};
+
+/**
+ * @class Gateway
+ * @brief Accepts clients and moves lines between them and a GameBackend.
+ */
+class Gateway {
+public:
+    Gateway(GameBackend& backend) : backend(backend), listener(-1), epoll(-1), clients(0) {
+        backend.gateway = this;
+    }
+
+    ~Gateway() {
+        if (epoll >= 0) close(epoll);
+        if (listener >= 0) close(listener);
+    }
+
+    /**
+     * @brief Starts listening.
+     * @return False on failure (errno set).
+     */
+    bool open(const SocketAddress& address) {
+        listener = listenOn(address);
+        epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (listener < 0 || epoll < 0) return false;
+        watch(listener, NULL, EPOLLIN | EPOLLET);
+        if (backend.descriptor() >= 0) {
+            setNonBlocking(backend.descriptor());
+            watch(backend.descriptor(), &backend, EPOLLIN | EPOLLET);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Serves clients until *running is cleared.
+     */
+    void run(volatile int* running) {
+        epoll_event events[256];
+        while (*running) {
+            int count = epoll_wait(epoll, events, 256, 100);
+            for (int i = 0; i < count; i++) {
+                void* owner = events[i].data.ptr;
+                if (owner == NULL) {
+                    acceptAll();
+                } else if (owner == &backend) {
+                    backend.onReadable();
+                } else {
+                    GatewayClient& client = *(GatewayClient*)owner;
+                    if (client.dead) continue;
+                    if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                        drop(client);
+                        continue;
+                    }
+                    if (events[i].events & EPOLLOUT) flush(client);
+                    if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                        client.readable = true;
+                        service(client);
+                    }
+                }
+            }
+            backend.tick();
+            for (size_t i = 0; i < graveyard.size(); i++) delete graveyard[i];
+            graveyard.clear();
+        }
+    }
+
+    /**
+     * @brief Queues reply bytes for a client and writes what the socket takes.
+     */
+    void deliver(GatewayClient& client, const std::string& text) {
+        if (client.dead) return;
+        client.output += text;
+        flush(client);
+        if (!client.throttled && client.output.size() >= OUTPUT_HIGH_WATER) {
+            client.throttled = true;
+            stats.throttled++;
+        }
+    }
+
+    /**
+     * @brief Handles the client's buffered lines and reads more while it is not held back.
+     */
+    void service(GatewayClient& client) {
+        if (client.servicing) return;
+        client.servicing = true;
+        while (!client.dead) {
+            handleLines(client);
+            if (client.dead || blocked(client) || !client.readable) break;
+            char buffer[4096];
+            ssize_t count = read(client.fd, buffer, sizeof(buffer));
+            if (count > 0) {
+                client.input.append(buffer, (size_t)count);
+            } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                client.readable = false;
+            } else if (count < 0 && errno == EINTR) {
+                continue;
+            } else {
+                drop(client);
+            }
+        }
+        client.servicing = false;
+    }
+
+    /// Prints the counters.
+    void report() const {
+        std::printf("clients: %llu accepted, %llu rejected, %llu at peak\n",
+            (unsigned long long)stats.accepted, (unsigned long long)stats.rejected, (unsigned long long)stats.peak);
+        std::printf("commands: %llu, %llu lines ignored, %llu backpressure stalls\n",
+            (unsigned long long)stats.commands, (unsigned long long)stats.ignored, (unsigned long long)stats.throttled);
+        backend.report();
+    }
+
+private:
+    void watch(int fd, void* owner, uint32_t events) {
+        epoll_event event;
+        event.events = events;
+        event.data.ptr = owner;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    void acceptAll() {
+        for (;;) {
+            int fd = accept4(listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return; // EAGAIN, or out of descriptors until a client leaves
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            GatewayClient* client = new GatewayClient(fd);
+            if (!backend.attach(*client)) {
+                static const char busy[] = "Error: Server busy!\r\n";
+                send(fd, busy, sizeof(busy) - 1, MSG_NOSIGNAL);
+                close(fd);
+                delete client;
+                stats.rejected++;
+                continue;
+            }
+            stats.accepted++;
+            if (++clients > stats.peak) stats.peak = clients;
+            watch(fd, client, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET);
+            service(*client);
+        }
+    }
+
+    bool blocked(const GatewayClient& client) const {
+        return client.throttled || !backend.accepting(client);
+    }
+
+    /// Passes complete lines to the backend while the client is not held back.
+    void handleLines(GatewayClient& client) {
+        size_t start = 0;
+        while (!client.dead && !blocked(client)) {
+            size_t end = client.input.find('\n', start);
+            if (end == std::string::npos) break;
+            std::string line = client.input.substr(start, end - start);
+            start = end + 1;
+            if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+            if (client.discarding) {
+                client.discarding = false;
+            } else if (line.size() > GATEWAY_MAX_LINE) {
+                deliver(client, "Error: Command too long!\r\n");
+            } else if (isGameCommand(line)) {
+                stats.commands++;
+                backend.submit(client, line);
+            } else {
+                stats.ignored++;
+            }
+        }
+        client.input.erase(0, start);
+        if (client.input.size() > GATEWAY_MAX_LINE && client.input.find('\n') == std::string::npos) {
+            // An overlong line without its end yet: keep only the fact that it is being skipped.
+            if (!client.discarding) deliver(client, "Error: Command too long!\r\n");
+            client.discarding = true;
+            client.input.clear();
+        }
+    }
+
+    void flush(GatewayClient& client) {
+        size_t sent = 0;
+        while (sent < client.output.size()) {
+            ssize_t count = send(client.fd, client.output.data() + sent, client.output.size() - sent, MSG_NOSIGNAL);
+            if (count > 0) {
+                sent += (size_t)count;
+            } else if (count < 0 && errno == EINTR) {
+                continue;
+            } else {
+                if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    drop(client);
+                    return;
+                }
+                break;
+            }
+        }
+        client.output.erase(0, sent);
+        if (client.throttled && client.output.size() < OUTPUT_LOW_WATER) {
+            client.throttled = false;
+            service(client);
+        }
+    }
+
+    void drop(GatewayClient& client) {
+        if (client.dead) return;
+        client.dead = true;
+        backend.detach(client);
+        close(client.fd);
+        clients--;
+        graveyard.push_back(&client);
+    }
+
+    GameBackend& backend;
+    int listener;
+    int epoll;
+    uint64_t clients;                       ///< Connected now.
+    std::vector<GatewayClient*> graveyard;  ///< Dropped during the current event batch.
+
+public:
+    GatewayStats stats;
+};
+
+/**
+ * @class SerialBackend
+ * @brief Plays every client in its own "@<id>" session of one board.
+ *
+ * A new client gets a free session id and a hidden "reset" for the board's
+ * session. Commands go out round-robin, one per session at a time and at
+ * most LINK_WINDOW in all, so the board's 64-byte RX buffer never
+ * overflows. The backend keeps each session's last board to drop the
+ * commands the firmware would ignore (moves on taken cells or after the
+ * game ended), so every command it sends is answered by exactly one board.
+ */
+class SerialBackend : public GameBackend {
+public:
+    /// Commands sent to the board and not answered yet.
+    static const int LINK_WINDOW = 4;
+
+    /**
+     * @param port Open serial port.
+     * @param slots Sessions to use, at most the firmware's SESSION_SLOTS.
+     */
+    SerialBackend(PosixSerialPort& port, uint8_t slots)
+        : port(port), inFlight(0), next(1), timeouts(0), sent(0), dropped(0) {
+        for (int id = slots; id >= 1; id--) freeIds.push_back((uint8_t)id);
+        for (int id = 0; id < 256; id++) sessions[id] = Session();
+    }
+
+    bool attach(GatewayClient& client) {
+        if (freeIds.empty()) return false;
+        client.session = freeIds.back();
+        freeIds.pop_back();
+        Session& s = sessions[client.session];
+        s.client = &client;
+        memset(s.cells, ' ', sizeof(s.cells));
+        s.queue.clear();
+        s.queue.push_back("reset");
+        s.hidden = 1;
+        dispatch();
+        return true;
+    }
+
+    void detach(GatewayClient& client) {
+        Session& s = sessions[client.session];
+        s.client = NULL;
+        s.queue.clear();
+        if (!s.busy) freeIds.push_back(client.session);
+    }
+
+    void submit(GatewayClient& client, const std::string& command) {
+        sessions[client.session].queue.push_back(command);
+        dispatch();
+    }
+
+    bool accepting(const GatewayClient& client) const {
+        return sessions[client.session].queue.size() < COMMAND_QUEUE_LIMIT;
+    }
+
+    int descriptor() const { return port.descriptor(); }
+
+    void onReadable() {
+        uint8_t buffer[256];
+        int count;
+        while ((count = port.read(buffer, sizeof(buffer), 0)) > 0) {
+            for (int i = 0; i < count; i++) {
+                if (buffer[i] == '\n') {
+                    handleLine();
+                    line.clear();
+                } else if (buffer[i] != '\r' && line.size() < 64) {
+                    line += (char)buffer[i];
+                }
+            }
+        }
+        dispatch();
+    }
+
+    void tick() {
+        GatewayClock::time_point now = GatewayClock::now();
+        for (int id = 1; id < 256; id++) {
+            Session& s = sessions[id];
+            if (s.busy && now - s.sent > std::chrono::seconds(2)) {
+                timeouts++;
+                s.hidden = 0;
+                complete((uint8_t)id);
+            }
+        }
+        dispatch();
+    }
+
+    void report() const {
+        std::printf("serial: %llu commands sent, %llu not sent (ignored by the firmware), %llu replies timed out\n",
+            (unsigned long long)sent, (unsigned long long)dropped, (unsigned long long)timeouts);
+    }
+
+private:
+    /// State of one session id.
+    struct Session {
+        GatewayClient* client = NULL;
+        std::deque<std::string> queue;  ///< Commands not sent yet.
+        char cells[9];                  ///< Last board received.
+        bool busy = false;              ///< A command is waiting for its board.
+        uint8_t hidden = 0;             ///< Boards still to swallow (the reset on attach).
+        GatewayClock::time_point sent;
+    };
+
+    /// @return True if the firmware answers the command with a board.
+    static bool answered(const Session& s, const std::string& command) {
+        if (command == "reset") return true;
+        if (boardFinished(s.cells)) return false;
+        if (command[1] != ',') return true;
+        return s.cells[(command[0] - '0') * 3 + (command[2] - '0')] == ' ';
+    }
+
+    /// Sends queued commands round-robin while the window has room.
+    void dispatch() {
+        for (int scanned = 0; scanned < 255 && inFlight < LINK_WINDOW; scanned++) {
+            uint8_t id = next;
+            next = next == 255 ? 1 : (uint8_t)(next + 1);
+            Session& s = sessions[id];
+            if (s.busy) continue;
+            while (!s.queue.empty() && !answered(s, s.queue.front())) {
+                s.queue.pop_front(); // the firmware would ignore it
+                dropped++;
+            }
+            if (s.queue.empty()) continue;
+            char text[24];
+            int length = snprintf(text, sizeof(text), "@%u %s\n", id, s.queue.front().c_str());
+            s.queue.pop_front();
+            port.write((const uint8_t*)text, (size_t)length);
+            s.busy = true;
+            s.sent = GatewayClock::now();
+            inFlight++;
+            sent++;
+            scanned = 0;
+            if (s.client != NULL) gateway->service(*s.client);
+        }
+    }
+
+    /// Ends the command in flight of a session.
+    void complete(uint8_t id) {
+        Session& s = sessions[id];
+        if (!s.busy) return;
+        s.busy = false;
+        inFlight--;
+        if (s.client == NULL) {
+            s.queue.clear();
+            freeIds.push_back(id);
+        }
+    }
+
+    /// Routes one "@<id> ..." line from the board.
+    void handleLine() {
+        if (line.empty() || line[0] != '@') return; // not a session reply
+        size_t space = line.find(' ');
+        int id = atoi(line.c_str() + 1);
+        if (space == std::string::npos || id < 1 || id > 255) return;
+        std::string reply = line.substr(space + 1);
+        Session& s = sessions[id];
+        if (isBoardLine(reply)) {
+            memcpy(s.cells, reply.data(), 9);
+            complete((uint8_t)id);
+            if (s.hidden > 0) {
+                s.hidden--;
+                return;
+            }
+        }
+        if (s.client != NULL) gateway->deliver(*s.client, reply + "\r\n");
+    }
+
+    PosixSerialPort& port;
+    Session sessions[256];
+    std::vector<uint8_t> freeIds;
+    std::string line;       ///< Partial line from the board.
+    int inFlight;
+    uint8_t next;           ///< Session dispatch() looks at first.
+    uint64_t timeouts;
+    uint64_t sent;
+    uint64_t dropped;       ///< Commands not sent because the firmware would ignore them.
+};
+
+#endif // GATEWAY_H
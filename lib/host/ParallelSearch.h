@@ -0,0 +1,751 @@
+/**
+ * @file ParallelSearch.h
+ * @brief Multithreaded Young Brothers Wait search for Board<N, K> on the host.
+ *
+ * Every node, the root included, searches its first (eldest) move alone to get
+ * a bound. At the root the remaining moves are then dealt round-robin into
+ * per-worker deques. Below the root, a node with at least SPLIT_DEPTH plies
+ * left turns into a split point once its eldest move is done and some worker
+ * is idle: the split point goes to the back of the owner's deque, and idle
+ * workers join it and claim its younger brothers one at a time, sharing
+ * alpha. A brother that fails high stops the others. A worker takes root
+ * moves from the front of its own deque and otherwise joins split points or
+ * steals root moves from the back of the others. An owner whose brothers are
+ * all claimed helps at split points below its own until its helpers are done.
+ * The workers also share a lock-free transposition table. The worker threads
+ * start with the searcher and sleep on a condition variable between
+ * iterations and calls. Tactical moves and tie-breaks match BoardSearch.
+ */
+#ifndef PARALLEL_SEARCH_H
+#define PARALLEL_SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BoardSearch.h"
+
+/**
+ * @struct ParallelStats
+ * @brief Work counters of the last ParallelSearch::findBestMove() call.
+ */
+struct ParallelStats {
+    uint64_t nodes = 0;      ///< Nodes searched by all workers.
+    uint64_t steals = 0;     ///< Root moves and split points taken from another worker's deque.
+    uint64_t splits = 0;     ///< Interior nodes whose moves were shared between workers.
+    uint64_t ttHits = 0;     ///< Transposition table probes that ended the node.
+    double seconds = 0;      ///< Wall-clock time.
+
+    /// @return Nodes per second.
+    double nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0; }
+};
+
+/**
+ * @class SharedTable
+ * @brief Lock-free transposition table shared by all workers.
+ * Every slot keeps the packed data word and key ^ data; a torn write from a
+ * concurrent store makes the check fail, so readers never see a mixed entry.
+ */
+class SharedTable {
+public:
+    enum Flag : uint8_t { EXACT = 1, LOWER = 2, UPPER = 3 };
+
+    /**
+     * @brief Decoded table entry.
+     */
+    struct Entry {
+        int32_t value; ///< Stored value or bound.
+        uint8_t depth; ///< Remaining depth of the search that stored it.
+        Flag flag;     ///< Meaning of value.
+        uint8_t move;  ///< Best move found, or 0xFF.
+    };
+
+    /**
+     * @brief Allocates the table.
+     * @param entries Number of slots, rounded down to a power of two.
+     */
+    explicit SharedTable(size_t entries) {
+        size_t size = 1;
+        while (size * 2 <= entries) size *= 2;
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+        clear();
+    }
+
+    /**
+     * @brief Empties every slot.
+     */
+    void clear() {
+        for (size_t i = 0; i <= mask; i++) {
+            slots[i].check.store(0, std::memory_order_relaxed);
+            slots[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Looks up a position.
+     * @param key Zobrist key.
+     * @param out Filled on a hit.
+     * @return True if the slot holds this key.
+     */
+    bool probe(uint64_t key, Entry& out) const {
+        const Slot& slot = slots[key & mask];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if (data == 0 || (check ^ data) != key) return false;
+        out.value = (int32_t)(uint32_t)data;
+        out.depth = (uint8_t)(data >> 32);
+        out.flag = (Flag)((data >> 40) & 0x3);
+        out.move = (uint8_t)(data >> 48);
+        return true;
+    }
+
+    /**
+     * @brief Stores a position, replacing whatever the slot held.
+     * @param key Zobrist key.
+     * @param entry Data to store.
+     */
+    void store(uint64_t key, const Entry& entry) {
+        uint64_t data = (uint64_t)(uint32_t)entry.value
+            | ((uint64_t)entry.depth << 32)
+            | ((uint64_t)entry.flag << 40)
+            | ((uint64_t)entry.move << 48);
+        Slot& slot = slots[key & mask];
+        slot.data.store(data, std::memory_order_relaxed);
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+};
+
+/**
+ * @class ParallelSearch
+ * @brief Iterative deepening with Young Brothers Wait splits over persistent worker threads.
+ * @tparam N Board side.
+ * @tparam K Marks in a row needed to win.
+ */
+template <uint8_t N, uint8_t K>
+class ParallelSearch {
+public:
+    typedef Board<N, K> BoardType;
+
+    /**
+     * @brief Creates the searcher and starts its worker threads.
+     * @param threads Number of worker threads (0 = all hardware threads).
+     * @param tableEntries Transposition table slots shared by the workers.
+     */
+    explicit ParallelSearch(unsigned threads = 0, size_t tableEntries = 1 << 20)
+        : table(tableEntries) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; i++) workers.emplace_back(new Worker(*this));
+        initKeys();
+        for (unsigned i = 0; i < threads; i++) pool.emplace_back(&ParallelSearch::serve, this, (size_t)i);
+    }
+
+    /// Stops and joins the worker threads.
+    ~ParallelSearch() {
+        {
+            std::lock_guard<std::mutex> guard(poolLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+    }
+
+    ParallelSearch(const ParallelSearch&) = delete;
+    ParallelSearch& operator=(const ParallelSearch&) = delete;
+
+    /// @return Number of worker threads.
+    unsigned threadCount() const { return (unsigned)workers.size(); }
+
+    /// @return Counters of the last search.
+    const ParallelStats& stats() const { return lastStats; }
+
+    /**
+     * @brief Finds the best move for the side to move.
+     * @param board The position (not modified).
+     * @param limits Depth, shared node budget and time budget.
+     * @return The chosen move; nodes is the total over all workers.
+     */
+    SearchResult findBestMove(const BoardType& board, SearchLimits limits) {
+        auto start = std::chrono::steady_clock::now();
+        lastStats = ParallelStats();
+        nodes.store(0);
+        steals.store(0);
+        splits.store(0);
+        ttHits.store(0);
+        aborted.store(false);
+        nodeLimit = limits.maxNodes;
+        timeLimit = limits.maxMicros;
+        started = searchMicros();
+        table.clear();
+
+        BoardType root = board;
+        SearchResult result = {-1, 0, 0, 0};
+        if (!root.isFull()) {
+            result.move = workers[0]->tacticalMove(root);
+            if (result.move < 0) {
+                result.move = workers[0]->priorityMove(root);
+                if (limits.maxDepth > 0) deepen(root, limits, result);
+            }
+        }
+
+        lastStats.nodes = nodes.load();
+        lastStats.steals = steals.load();
+        lastStats.splits = splits.load();
+        lastStats.ttHits = ttHits.load();
+        lastStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.nodes = (uint32_t)lastStats.nodes;
+        return result;
+    }
+
+private:
+    /**
+     * @struct SplitPoint
+     * @brief An interior node whose remaining moves are open to idle workers.
+     * Lives on the stack of the worker that created it (the owner), which
+     * does not return before every helper has left.
+     */
+    struct SplitPoint {
+        const SplitPoint* parent;          ///< Split point above this one, or 0 below a root move.
+        BoardType board;                   ///< Position of the node.
+        uint64_t hash;                     ///< Zobrist key of the node.
+        uint8_t depth;                     ///< Remaining depth of the node.
+        uint8_t ply;                       ///< Distance from the root.
+        int32_t beta;                      ///< Upper bound of the node.
+        uint8_t moves[BoardType::CELLS];   ///< Brothers not searched by the owner before the split.
+        uint8_t count;                     ///< Number of moves.
+        std::atomic<bool> cutoff{false};   ///< A brother failed high; the others stop.
+        std::atomic<int> helpers{0};       ///< Workers besides the owner still attached.
+        std::mutex lock;                   ///< Guards the fields below.
+        uint8_t next;                      ///< Index of the next unclaimed move.
+        int32_t alpha;                     ///< Lower bound, raised by every finished brother.
+        int32_t best;                      ///< Best score so far.
+        uint8_t bestMove;                  ///< Move with that score.
+        uint8_t cutMove;                   ///< Move that failed high, or NO_MOVE.
+    };
+
+    /**
+     * @struct Task
+     * @brief Deque entry: a root move, or a split point that other workers may join.
+     */
+    struct Task {
+        SplitPoint* split;   ///< Split point to join, or 0 for a root move.
+        uint8_t move;        ///< Root move when split is 0.
+    };
+
+    /**
+     * @class Worker
+     * @brief One search thread: own board copy, killers, history and a deque of tasks.
+     */
+    class Worker : public BoardSearch<N, K> {
+    public:
+        typedef BoardSearch<N, K> Base;
+        using Base::tacticalMove;
+        using Base::priorityMove;
+        using Base::generateMoves;
+        using Base::moveToFront;
+
+        explicit Worker(ParallelSearch& owner) : owner(owner) {}
+
+        /**
+         * @brief Searches one root move.
+         * @param root Root position.
+         * @param move Root move.
+         * @param depth Iteration depth.
+         * @param alpha Bound from the best move so far.
+         * @return Score of the move for the root side, valid unless the search aborted.
+         */
+        int32_t searchRoot(const BoardType& root, uint8_t move, uint8_t depth, int32_t alpha) {
+            board = root;
+            uint64_t hash = owner.hashOf(board);
+            hash ^= owner.keys[board.sideToMove() - 1][move] ^ owner.sideKey;
+            board.place(move);
+            return -search(depth - 1, 1, -WIN_SCORE - 1, -alpha, hash, 0);
+        }
+
+        /**
+         * @brief Claims and searches moves of a split point until none are left or a brother failed high.
+         * Leaves the board at the split point's position.
+         */
+        void work(SplitPoint& split) {
+            board = split.board;
+            Mark side = board.sideToMove();
+            for (;;) {
+                uint8_t move;
+                int32_t alpha;
+                {
+                    std::lock_guard<std::mutex> guard(split.lock);
+                    if (split.cutoff.load(std::memory_order_relaxed) || split.next == split.count) return;
+                    move = split.moves[split.next++];
+                    alpha = split.alpha;
+                }
+                uint64_t child = split.hash ^ owner.keys[side - 1][move] ^ owner.sideKey;
+                board.place(move);
+                int32_t value = -search(split.depth - 1, split.ply + 1, -split.beta, -alpha, child, &split);
+                board.undo(move);
+                if (owner.stopped(&split)) return;
+
+                std::lock_guard<std::mutex> guard(split.lock);
+                if (value > split.best) {
+                    split.best = value;
+                    split.bestMove = move;
+                }
+                if (value > split.alpha) split.alpha = value;
+                if (split.alpha >= split.beta && !split.cutoff.load(std::memory_order_relaxed)) {
+                    split.cutMove = move;
+                    split.cutoff.store(true);
+                }
+            }
+        }
+
+        /**
+         * @brief Adds the locally counted nodes and hits to the shared counters.
+         * @return False if that used up the node budget (aborted is then set).
+         */
+        bool publish() {
+            uint64_t visited = owner.nodes.fetch_add(localNodes, std::memory_order_relaxed) + localNodes;
+            owner.ttHits.fetch_add(localHits, std::memory_order_relaxed);
+            localNodes = 0;
+            localHits = 0;
+            if (owner.nodeLimit != 0 && visited > owner.nodeLimit) {
+                owner.aborted.store(true);
+                return false;
+            }
+            return true;
+        }
+
+        BoardType board;             ///< Position being searched.
+        std::mutex lock;             ///< Guards tasks.
+        std::deque<Task> tasks;      ///< Root moves at the front, own split points at the back.
+
+    private:
+        /// Nodes a worker counts on its own before it adds them to the shared counter.
+        static const uint32_t NODE_BATCH = 1024;
+        /// Smallest remaining depth at which a node offers its younger brothers to idle workers.
+        static const uint8_t SPLIT_DEPTH = 2;
+
+        /**
+         * @brief Negamax alpha-beta with the shared transposition table.
+         * @param within Innermost split point above the node, or 0; its cutoff stops the search.
+         */
+        int32_t search(uint8_t depth, uint8_t ply, int32_t alpha, int32_t beta, uint64_t hash,
+                       const SplitPoint* within) {
+            if (owner.stopped(within)) return 0;
+            if (++localNodes % Base::CLOCK_INTERVAL == 0) {
+                if (owner.timeLimit != 0 && searchMicros() - owner.started >= owner.timeLimit) {
+                    owner.aborted.store(true);
+                    return 0;
+                }
+                if (localNodes >= NODE_BATCH && !publish()) return 0;
+            }
+            if (board.winner() != MARK_NONE) return -(WIN_SCORE - ply);
+            if (board.isFull()) return 0;
+            if (depth == 0) return board.evaluate();
+
+            uint8_t hashMove = Base::NO_MOVE;
+            SharedTable::Entry entry;
+            if (owner.table.probe(hash, entry)) {
+                hashMove = entry.move;
+                if (entry.depth >= depth) {
+                    int32_t value = Base::fromTable(entry.value, ply);
+                    if (entry.flag == SharedTable::EXACT
+                        || (entry.flag == SharedTable::LOWER && value >= beta)
+                        || (entry.flag == SharedTable::UPPER && value <= alpha)) {
+                        localHits++;
+                        return value;
+                    }
+                }
+            }
+
+            uint8_t moves[Base::CELLS];
+            uint8_t count = this->generateMoves(board, moves);
+            this->orderMoves(board, ply, moves, count);
+            if (hashMove != Base::NO_MOVE) moveToFront(moves, count, hashMove);
+
+            Mark side = board.sideToMove();
+            int32_t originalAlpha = alpha;
+            int32_t best = -WIN_SCORE - 1;
+            uint8_t bestMove = Base::NO_MOVE;
+            for (uint8_t i = 0; i < count; i++) {
+                if (i > 0 && depth >= SPLIT_DEPTH && count - i > 1
+                    && owner.idleWorkers.load(std::memory_order_relaxed) > 0) {
+                    // The eldest brother gave the bound; the younger ones may now run in parallel.
+                    SplitPoint split;
+                    split.parent = within;
+                    split.board = board;
+                    split.hash = hash;
+                    split.depth = depth;
+                    split.ply = ply;
+                    split.beta = beta;
+                    split.count = count - i;
+                    for (uint8_t j = i; j < count; j++) split.moves[j - i] = moves[j];
+                    split.next = 0;
+                    split.alpha = alpha;
+                    split.best = best;
+                    split.bestMove = bestMove;
+                    split.cutMove = Base::NO_MOVE;
+                    owner.share(*this, split);
+                    if (owner.stopped(within)) return 0;
+                    best = split.best;
+                    bestMove = split.bestMove;
+                    if (split.cutMove != Base::NO_MOVE) noteCutoff(side, ply, split.cutMove, depth);
+                    break;
+                }
+                uint8_t move = moves[i];
+                uint64_t child = hash ^ owner.keys[side - 1][move] ^ owner.sideKey;
+                board.place(move);
+                int32_t value = -search(depth - 1, ply + 1, -beta, -alpha, child, within);
+                board.undo(move);
+                if (owner.stopped(within)) return 0;
+                if (value > best) {
+                    best = value;
+                    bestMove = move;
+                }
+                if (best > alpha) alpha = best;
+                if (alpha >= beta) {
+                    noteCutoff(side, ply, move, depth);
+                    break;
+                }
+            }
+
+            SharedTable::Entry stored;
+            stored.value = Base::toTable(best, ply);
+            stored.depth = depth;
+            stored.move = bestMove;
+            if (best <= originalAlpha) stored.flag = SharedTable::UPPER;
+            else if (best >= beta) stored.flag = SharedTable::LOWER;
+            else stored.flag = SharedTable::EXACT;
+            owner.table.store(hash, stored);
+            return best;
+        }
+
+        /// Records a move that failed high in the killers and the history.
+        void noteCutoff(Mark side, uint8_t ply, uint8_t move, uint8_t depth) {
+            if (this->killers[ply][0] != move) {
+                this->killers[ply][1] = this->killers[ply][0];
+                this->killers[ply][0] = move;
+            }
+            this->addHistory(side, move, depth);
+        }
+
+        ParallelSearch& owner;
+        uint32_t localNodes = 0;     ///< Nodes not yet added to owner.nodes.
+        uint32_t localHits = 0;      ///< Table cutoffs not yet added to owner.ttHits.
+    };
+
+    /**
+     * @brief Iterative deepening loop; fills result with the last completed depth.
+     */
+    void deepen(const BoardType& root, SearchLimits limits, SearchResult& result) {
+        uint8_t moves[BoardType::CELLS];
+        uint8_t count = workers[0]->generateMoves(root, moves);
+        uint8_t empty = BoardType::CELLS - root.markCount();
+
+        for (uint8_t depth = 1; depth <= limits.maxDepth; depth++) {
+            bestMove = moves[0];
+            best = -WIN_SCORE - 1;
+            runIteration(root, moves, count, depth);
+            if (aborted.load()) {
+                // Same rule as BoardSearch: a finished root move that beat the previous best stands.
+                if (bestMove != moves[0] && result.depth > 0) {
+                    result.move = bestMove;
+                    result.value = best;
+                }
+                break;
+            }
+
+            result.move = bestMove;
+            result.value = best;
+            result.depth = depth;
+            Worker::moveToFront(moves, count, bestMove);
+            if (best >= WIN_SCORE - BoardType::CELLS - 1 || best <= -WIN_SCORE + BoardType::CELLS + 1) break;
+            if (depth >= empty) break;
+        }
+        for (size_t w = 0; w < workers.size(); w++) workers[w]->tasks.clear();
+    }
+
+    /**
+     * @brief Wakes every worker for one iteration and waits until all are idle again.
+     */
+    void runIteration(const BoardType& root, const uint8_t* moves, uint8_t count, uint8_t depth) {
+        std::unique_lock<std::mutex> guard(poolLock);
+        jobRoot = &root;
+        jobMoves = moves;
+        jobCount = count;
+        jobDepth = depth;
+        rootPending.store(count);
+        idleWorkers.store(0);
+        busy = workers.size();
+        generation++;
+        wake.notify_all();
+        idle.wait(guard, [this] { return busy == 0; });
+        jobRoot = 0;
+    }
+
+    /**
+     * @brief Body of a pool thread: sleeps until the next iteration or the destructor.
+     */
+    void serve(size_t index) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> guard(poolLock);
+                wake.wait(guard, [this, seen] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            runWorker(index);
+            workers[index]->publish();
+            std::lock_guard<std::mutex> guard(poolLock);
+            if (--busy == 0) idle.notify_one();
+        }
+    }
+
+    /**
+     * @brief One iteration of a worker.
+     * Worker 0 searches the eldest root move, helped only through split points,
+     * and then deals the other root moves. Every worker then takes root moves
+     * from its own deque, steals root moves or joins split points of the
+     * others, until all root moves are done.
+     */
+    void runWorker(size_t index) {
+        Worker& self = *workers[index];
+        if (index == 0) {
+            searchRootMove(self, jobMoves[0], -WIN_SCORE - 1);
+            for (uint8_t i = 1; i < jobCount; i++) {
+                Worker& target = *workers[(i - 1) % workers.size()];
+                std::lock_guard<std::mutex> guard(target.lock);
+                target.tasks.push_back(Task{0, jobMoves[i]});
+            }
+        }
+
+        bool waiting = false;
+        while (!aborted.load(std::memory_order_relaxed) && rootPending.load() > 0) {
+            Task task;
+            if (!takeTask(index, task)) {
+                if (!waiting) idleWorkers.fetch_add(1);
+                waiting = true;
+                std::this_thread::yield();
+                continue;
+            }
+            if (waiting) idleWorkers.fetch_sub(1);
+            waiting = false;
+            if (task.split != 0) {
+                self.work(*task.split);
+                task.split->helpers.fetch_sub(1);
+                continue;
+            }
+            int32_t alpha;
+            {
+                std::lock_guard<std::mutex> guard(resultLock);
+                alpha = best - 1;
+            }
+            searchRootMove(self, task.move, alpha);
+        }
+        if (waiting) idleWorkers.fetch_sub(1);
+    }
+
+    /**
+     * @brief Searches a root move and merges its score into best and bestMove.
+     */
+    void searchRootMove(Worker& self, uint8_t move, int32_t alpha) {
+        int32_t value = self.searchRoot(*jobRoot, move, jobDepth, alpha);
+        if (aborted.load(std::memory_order_relaxed)) return;
+        {
+            std::lock_guard<std::mutex> guard(resultLock);
+            if (value > best || (value == best && prefer(*jobRoot, move, bestMove))) {
+                best = value;
+                bestMove = move;
+            }
+        }
+        rootPending.fetch_sub(1);
+    }
+
+    /**
+     * @brief Pops a root move from the own deque, or takes a split point or a root move from another worker.
+     * A taken split point stays in its owner's deque so more workers can join; helpers is raised for it.
+     */
+    bool takeTask(size_t index, Task& task) {
+        {
+            Worker& self = *workers[index];
+            std::lock_guard<std::mutex> guard(self.lock);
+            if (!self.tasks.empty() && self.tasks.front().split == 0) {
+                task = self.tasks.front();
+                self.tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t k = 1; k < workers.size(); k++) {
+            Worker& victim = *workers[(index + k) % workers.size()];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            for (size_t i = victim.tasks.size(); i-- > 0;) {
+                task = victim.tasks[i];
+                if (task.split == 0) {
+                    victim.tasks.erase(victim.tasks.begin() + i);
+                } else if (isOpen(*task.split)) {
+                    task.split->helpers.fetch_add(1);
+                } else {
+                    continue;
+                }
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Offers the younger brothers of a node to idle workers and searches them together.
+     * Returns once every move is done or a brother failed high, and every helper has left.
+     * While it waits, the owner helps at split points below its own.
+     */
+    void share(Worker& self, SplitPoint& split) {
+        splits.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> guard(self.lock);
+            self.tasks.push_back(Task{&split, 0});
+        }
+        self.work(split);
+        {
+            std::lock_guard<std::mutex> guard(self.lock);
+            for (size_t i = self.tasks.size(); i-- > 0;) {
+                if (self.tasks[i].split == &split) {
+                    self.tasks.erase(self.tasks.begin() + i);
+                    break;
+                }
+            }
+        }
+        while (split.helpers.load() > 0) {
+            SplitPoint* below = findSplitBelow(split);
+            if (below == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            self.work(*below);
+            below->helpers.fetch_sub(1);
+        }
+        self.board = split.board;
+    }
+
+    /**
+     * @brief Finds a split point under the given one in any deque and attaches to it.
+     * @return The split point, or 0 if there is none.
+     */
+    SplitPoint* findSplitBelow(const SplitPoint& split) {
+        for (size_t w = 0; w < workers.size(); w++) {
+            Worker& victim = *workers[w];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            for (size_t i = victim.tasks.size(); i-- > 0;) {
+                SplitPoint* candidate = victim.tasks[i].split;
+                if (candidate == 0) break;
+                if (!isOpen(*candidate)) continue;
+                for (const SplitPoint* up = candidate->parent; up != 0; up = up->parent) {
+                    if (up != &split) continue;
+                    candidate->helpers.fetch_add(1);
+                    return candidate;
+                }
+            }
+        }
+        return 0;
+    }
+
+    /// @return True if the split point still has moves to claim; the caller holds the owner's deque lock.
+    static bool isOpen(SplitPoint& split) {
+        std::lock_guard<std::mutex> guard(split.lock);
+        return !split.cutoff.load(std::memory_order_relaxed) && split.next < split.count;
+    }
+
+    /**
+     * @brief Tells whether a search below the given split point must stop.
+     * @return True if the budget ran out or a brother at this or an enclosing split point failed high.
+     */
+    bool stopped(const SplitPoint* split) const {
+        if (aborted.load(std::memory_order_relaxed)) return true;
+        for (; split != 0; split = split->parent) {
+            if (split->cutoff.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    /// Same tie-break as BoardSearch: higher priority, then lower cell index.
+    static bool prefer(const BoardType& root, uint8_t move, uint8_t current) {
+        uint8_t p = root.priority(move);
+        uint8_t q = root.priority(current);
+        if (p != q) return p > q;
+        return move < current;
+    }
+
+    /**
+     * @brief Fills the Zobrist keys from a fixed splitmix64 sequence.
+     */
+    void initKeys() {
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        auto next = [&state]() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        };
+        for (int side = 0; side < 2; side++) {
+            for (int cell = 0; cell < BoardType::CELLS; cell++) keys[side][cell] = next();
+        }
+        sideKey = next();
+    }
+
+    /**
+     * @brief Computes the Zobrist key of a position from scratch.
+     */
+    uint64_t hashOf(const BoardType& board) const {
+        uint64_t hash = board.sideToMove() == MARK_O ? sideKey : 0;
+        for (int cell = 0; cell < BoardType::CELLS; cell++) {
+            if (board.at(cell) != MARK_NONE) hash ^= keys[board.at(cell) - 1][cell];
+        }
+        return hash;
+    }
+
+    SharedTable table;                              ///< Shared transposition table.
+    std::vector<std::unique_ptr<Worker>> workers;   ///< One per thread.
+    uint64_t keys[2][BoardType::CELLS];             ///< Zobrist keys per side and cell.
+    uint64_t sideKey = 0;                           ///< Zobrist key for O to move.
+    std::atomic<uint64_t> nodes{0};                 ///< Shared node counter.
+    std::atomic<uint64_t> steals{0};                ///< Root moves stolen and split points joined.
+    std::atomic<uint64_t> splits{0};                ///< Split points opened.
+    std::atomic<uint64_t> ttHits{0};                ///< Table cutoffs.
+    std::atomic<bool> aborted{false};               ///< Node or time budget exhausted.
+    uint64_t nodeLimit = 0;                         ///< Node budget (0 = none); may overrun by a batch per worker.
+    uint32_t timeLimit = 0;                         ///< Time budget in microseconds (0 = none).
+    uint32_t started = 0;                           ///< searchMicros() when the search began.
+    std::atomic<int> idleWorkers{0};                ///< Workers looking for something to do.
+    std::atomic<int> rootPending{0};                ///< Root moves of the iteration not finished yet.
+    std::mutex resultLock;                          ///< Guards best and bestMove.
+    int32_t best = 0;                               ///< Best root score of the running iteration.
+    uint8_t bestMove = 0;                           ///< Root move with that score.
+    ParallelStats lastStats;                        ///< Counters of the last call.
+    std::vector<std::thread> pool;                  ///< Pool threads, one per worker.
+    std::mutex poolLock;                            ///< Guards the fields below.
+    std::condition_variable wake;                   ///< Signals a new iteration or stopping.
+    std::condition_variable idle;                   ///< Signals that busy reached 0.
+    uint64_t generation = 0;                        ///< Iterations handed to the pool.
+    size_t busy = 0;                                ///< Workers still in the current iteration.
+    const BoardType* jobRoot = 0;                   ///< Root of the current iteration.
+    const uint8_t* jobMoves = 0;                    ///< Root moves, previous best first.
+    uint8_t jobCount = 0;                           ///< Number of root moves.
+    uint8_t jobDepth = 0;                           ///< Depth of the current iteration.
+    bool stopping = false;                          ///< Set by the destructor.
+};
+
+#endif // PARALLEL_SEARCH_H
@@ -0,0 +1,302 @@
+/**
+ * @file Tournament.h
+ * @brief Headless self-play of the firmware AI against reference opponents on all cores.
+ *
+ * Four kinds of player take part, each usable as X (first) or O (second):
+ *   ai        - the firmware AI; its reply comes from MoveTable.h, which holds
+ *               bbFindBestMove() for every position (regenerate it with
+ *               "make movetable" after changing the AI, then rerun)
+ *   minimax   - perfect play from a solved game tree, random among the best moves
+ *   heuristic - win, block, fork, otherwise the highest-priority free cell
+ *   random    - a uniformly random free cell
+ * Every pairing of X and O is played, so the AI is measured moving first and
+ * second and the pairings without the AI give the PvP baselines. Each thread
+ * plays its share of every pairing into its own MatchTally array; the arrays
+ * are merged once all threads have finished, so games never contend.
+ */
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "BitBoard.h"
+#include "MoveTable.h"
+
+/**
+ * @enum PlayerKind
+ * @brief Strategy of one side.
+ */
+enum PlayerKind {
+    PLAYER_AI = 0,
+    PLAYER_MINIMAX = 1,
+    PLAYER_HEURISTIC = 2,
+    PLAYER_RANDOM = 3,
+    PLAYER_KINDS = 4
+};
+
+/// Names of the player kinds, indexed by PlayerKind.
+const char* const PLAYER_NAMES[PLAYER_KINDS] = {"ai", "minimax", "heuristic", "random"};
+
+/// Number of ternary board codes (3^9).
+const int BOARD_CODES = 19683;
+
+/**
+ * @struct MatchTally
+ * @brief Results of one X/O pairing.
+ */
+struct MatchTally {
+    uint64_t games = 0;
+    uint64_t xWins = 0;
+    uint64_t oWins = 0;
+    uint64_t draws = 0;
+    uint64_t moves[2][9] = {};    ///< Cells chosen by X and by O.
+    uint64_t openings[9] = {};    ///< First move of X.
+    uint64_t lengths[10] = {};    ///< Games by number of moves.
+
+    /// Adds another tally to this one.
+    void merge(const MatchTally& other) {
+        games += other.games;
+        xWins += other.xWins;
+        oWins += other.oWins;
+        draws += other.draws;
+        for (int side = 0; side < 2; side++) {
+            for (int cell = 0; cell < 9; cell++) moves[side][cell] += other.moves[side][cell];
+        }
+        for (int cell = 0; cell < 9; cell++) openings[cell] += other.openings[cell];
+        for (int length = 0; length < 10; length++) lengths[length] += other.lengths[length];
+    }
+};
+
+/**
+ * @struct FastRandom
+ * @brief xorshift64* generator, one per thread.
+ */
+struct FastRandom {
+    uint64_t state;
+
+    explicit FastRandom(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    /// @return A uniformly chosen set bit of a non-empty mask.
+    uint8_t pick(uint16_t mask) {
+        uint8_t skip = (uint8_t)((next() >> 32) % bitCount(mask));
+        while (skip--) mask &= mask - 1;
+        return (uint8_t)firstCell(mask);
+    }
+};
+
+/**
+ * @class Tournament
+ * @brief Plays every pairing of PlayerKind on a thread pool.
+ */
+class Tournament {
+public:
+    /**
+     * @param threads Worker threads (0 = all hardware threads).
+     */
+    explicit Tournament(unsigned threads = 0) : threads(threads), elapsed(0) {
+        if (this->threads == 0) this->threads = std::thread::hardware_concurrency();
+        if (this->threads == 0) this->threads = 1;
+        for (int code = 0; code < BOARD_CODES; code++) outcome[code] = UNSOLVED;
+        solve(0, 0);
+    }
+
+    /// @return Number of worker threads.
+    unsigned threadCount() const { return threads; }
+
+    /**
+     * @brief Plays gamesPerMatch games of every pairing.
+     * @param gamesPerMatch Games per X/O pairing.
+     * @param seed Base seed; thread t uses seed + t.
+     */
+    void run(uint64_t gamesPerMatch, uint64_t seed) {
+        std::vector<Shard> shards(threads);
+        std::vector<std::thread> pool;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < threads; t++) {
+            uint64_t share = gamesPerMatch / threads + (t < gamesPerMatch % threads ? 1 : 0);
+            pool.emplace_back(&Tournament::play, this, share, seed + t, &shards[t]);
+        }
+        for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int x = 0; x < PLAYER_KINDS; x++) {
+            for (int o = 0; o < PLAYER_KINDS; o++) {
+                results[x][o] = MatchTally();
+                for (unsigned t = 0; t < threads; t++) results[x][o].merge(shards[t].tally[x][o]);
+            }
+        }
+    }
+
+    /// @return Merged results of X kind x against O kind o.
+    const MatchTally& result(PlayerKind x, PlayerKind o) const { return results[x][o]; }
+
+    /// @return Games played by the last run().
+    uint64_t totalGames() const {
+        uint64_t games = 0;
+        for (int x = 0; x < PLAYER_KINDS; x++) {
+            for (int o = 0; o < PLAYER_KINDS; o++) games += results[x][o].games;
+        }
+        return games;
+    }
+
+    /// @return Wall-clock time of the last run().
+    double seconds() const { return elapsed; }
+
+    /**
+     * @brief Chooses a move for the side to move.
+     * @param kind Strategy.
+     * @param b The position from the mover's side: ai = own marks, player = opponent's.
+     * @param random Generator of the calling thread.
+     * @return Cell index 0..8.
+     */
+    int8_t chooseMove(PlayerKind kind, BitBoard b, FastRandom& random) const {
+        uint16_t empty = bbEmpty(b);
+        switch (kind) {
+        case PLAYER_AI: {
+            int16_t index = positionIndex(b);
+            if (index < 0) return random.pick(empty);
+            uint8_t packed = pgm_read_byte(&MOVE_TABLE[index >> 1]);
+            uint8_t cell = (index & 1) ? (packed >> 4) : (packed & 0x0F);
+            return cell == NO_TABLE_MOVE ? random.pick(empty) : (int8_t)cell;
+        }
+        case PLAYER_MINIMAX: {
+            // Best outcome for the mover is the worst one for the opponent afterwards.
+            int8_t best = 2;
+            uint16_t bestCells = 0;
+            for (uint16_t rest = empty; rest; rest &= rest - 1) {
+                uint8_t cell = (uint8_t)firstCell(rest);
+                int8_t value = outcome[encode(b.player, b.ai | (uint16_t)(1 << cell))];
+                if (value < best) {
+                    best = value;
+                    bestCells = 0;
+                }
+                if (value == best) bestCells |= (uint16_t)(1 << cell);
+            }
+            return random.pick(bestCells);
+        }
+        case PLAYER_HEURISTIC: {
+            uint16_t cells = bbThreats(b.ai, b.player);
+            if (cells == 0) cells = bbThreats(b.player, b.ai);
+            if (cells == 0) {
+                int8_t fork = bbFindForkMove(b, true);
+                if (fork >= 0) return fork;
+                uint8_t bestPriority = 0;
+                for (uint16_t rest = empty; rest; rest &= rest - 1) {
+                    uint8_t cell = (uint8_t)firstCell(rest);
+                    if (POSITION_PRIORITY[cell] > bestPriority) {
+                        bestPriority = POSITION_PRIORITY[cell];
+                        cells = 0;
+                    }
+                    if (POSITION_PRIORITY[cell] == bestPriority) cells |= (uint16_t)(1 << cell);
+                }
+            }
+            return random.pick(cells);
+        }
+        default:
+            return random.pick(empty);
+        }
+    }
+
+private:
+    static const int8_t UNSOLVED = 2;
+
+    /**
+     * @struct Shard
+     * @brief Accumulators of one thread, padded away from its neighbours.
+     */
+    struct alignas(64) Shard {
+        MatchTally tally[PLAYER_KINDS][PLAYER_KINDS];
+    };
+
+    /// Ternary code of a position: digit 1 for the side to move, 2 for the other.
+    static int encode(uint16_t mover, uint16_t other) {
+        int code = 0;
+        for (int cell = 8; cell >= 0; cell--) {
+            code = code * 3 + ((mover >> cell) & 1 ? 1 : (other >> cell) & 1 ? 2 : 0);
+        }
+        return code;
+    }
+
+    static bool hasLine(uint16_t marks) {
+        for (uint8_t i = 0; i < WIN_LINE_COUNT; i++) {
+            if ((marks & WIN_LINES[i]) == WIN_LINES[i]) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Solves the game tree below a position.
+     * @return 1 if the side to move wins with perfect play, -1 if it loses, 0 for a draw.
+     */
+    int8_t solve(uint16_t mover, uint16_t other) {
+        int code = encode(mover, other);
+        if (outcome[code] != UNSOLVED) return outcome[code];
+        int8_t value;
+        uint16_t empty = ~(mover | other) & FULL_BOARD;
+        if (hasLine(other)) {
+            value = -1;
+        } else if (empty == 0) {
+            value = 0;
+        } else {
+            value = -1;
+            for (; empty; empty &= empty - 1) {
+                int8_t reply = (int8_t)-solve(other, mover | (uint16_t)(1 << firstCell(empty)));
+                if (reply > value) value = reply;
+            }
+        }
+        outcome[code] = value;
+        return value;
+    }
+
+    /**
+     * @brief Thread body: plays its share of every pairing.
+     */
+    void play(uint64_t games, uint64_t seed, Shard* shard) const {
+        FastRandom random(seed);
+        for (int x = 0; x < PLAYER_KINDS; x++) {
+            for (int o = 0; o < PLAYER_KINDS; o++) {
+                PlayerKind kinds[2] = {(PlayerKind)x, (PlayerKind)o};
+                MatchTally& tally = shard->tally[x][o];
+                for (uint64_t game = 0; game < games; game++) {
+                    playGame(kinds, random, tally);
+                }
+            }
+        }
+    }
+
+    void playGame(const PlayerKind kinds[2], FastRandom& random, MatchTally& tally) const {
+        uint16_t marks[2] = {0, 0};
+        int ply = 0;
+        int winner = -1;
+        for (; ply < 9 && winner < 0; ply++) {
+            int side = ply & 1;
+            BitBoard view = {marks[side], marks[side ^ 1]};
+            int8_t cell = chooseMove(kinds[side], view, random);
+            marks[side] |= (uint16_t)(1 << cell);
+            tally.moves[side][cell]++;
+            if (ply == 0) tally.openings[cell]++;
+            if (hasLine(marks[side])) winner = side;
+        }
+        tally.games++;
+        tally.lengths[ply]++;
+        if (winner == 0) tally.xWins++;
+        else if (winner == 1) tally.oWins++;
+        else tally.draws++;
+    }
+
+    unsigned threads;
+    double elapsed;
+    int8_t outcome[BOARD_CODES]; ///< solve() value of every position, by encode().
+    MatchTally results[PLAYER_KINDS][PLAYER_KINDS];
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,183 @@
+/**
+ * @file bench.cpp
+ * @brief Host benchmark of the firmware AI (task3.ino built against the Arduino shim).
+ *
+ * Enumerates every position the AI can face in a real game (both "player"
+ * and "ai" first, stopping at wins and full boards) and measures for each:
+ * the time of findBestMove() (the search), the time of the move table
+ * lookup used by makeAIMove(), and the minimax nodes visited. Prints a
+ * summary and writes all figures as JSON so runs can be diffed.
+ * Usage: bench [output.json] [repetitions]
+ */
+
+#include "task3.ino"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @struct Sample
+ * @brief Measurements for one position.
+ */
+struct Sample {
+    std::string cells;   ///< Row-major board, ' ', 'X' or 'O'.
+    double searchNs;     ///< Mean findBestMove() time.
+    double lookupNs;     ///< Mean table lookup time.
+    uint32_t nodes;      ///< Minimax nodes of one findBestMove() call.
+};
+
+/**
+ * @struct Summary
+ * @brief Distribution of one measured quantity.
+ */
+struct Summary {
+    double mean, p50, p99, max;
+    size_t worst; ///< Index of the sample with the maximum.
+};
+
+/**
+ * @brief Collects every position with the AI ('O') to move that occurs in play.
+ * @param cells Current position.
+ * @param aiToMove Side to move.
+ * @param seen Codes of positions already collected.
+ * @param out Collected positions.
+ */
+void collectPositions(std::string& cells, bool aiToMove, std::vector<bool>& seen, std::vector<std::string>& out) {
+    BitBoard b = {0, 0};
+    int code = 0;
+    for (int i = 8; i >= 0; i--) {
+        code = code * 3 + (cells[i] == 'O' ? 1 : cells[i] == 'X' ? 2 : 0);
+        if (cells[i] == 'O') b.ai |= 1 << i;
+        if (cells[i] == 'X') b.player |= 1 << i;
+    }
+    if (bbEvaluate(b) != 0 || bbEmpty(b) == 0) return;
+    if (aiToMove) {
+        if (seen[code]) return;
+        seen[code] = true;
+        out.push_back(cells);
+    }
+    for (int i = 0; i < 9; i++) {
+        if (cells[i] != ' ') continue;
+        cells[i] = aiToMove ? 'O' : 'X';
+        collectPositions(cells, !aiToMove, seen, out);
+        cells[i] = ' ';
+    }
+}
+
+/**
+ * @brief Loads a position into the firmware's global board.
+ * @param cells Row-major board.
+ */
+void loadBoard(const std::string& cells) {
+    for (int i = 0; i < 9; i++) board[i / 3][i % 3] = cells[i];
+}
+
+/**
+ * @brief Computes mean, percentiles and maximum of a field.
+ * @param samples Measurements.
+ * @param field Member to summarize.
+ * @return The summary.
+ */
+template <class T>
+Summary summarize(const std::vector<Sample>& samples, T Sample::*field) {
+    std::vector<double> values;
+    Summary s = {0, 0, 0, 0, 0};
+    for (size_t i = 0; i < samples.size(); i++) {
+        double v = samples[i].*field;
+        values.push_back(v);
+        s.mean += v;
+        if (v > s.max) {
+            s.max = v;
+            s.worst = i;
+        }
+    }
+    if (values.empty()) return s;
+    s.mean /= values.size();
+    std::sort(values.begin(), values.end());
+    s.p50 = values[values.size() / 2];
+    s.p99 = values[std::min(values.size() - 1, values.size() * 99 / 100)];
+    return s;
+}
+
+/**
+ * @brief Writes a summary as a JSON object.
+ */
+void writeSummary(FILE* out, const char* name, const Summary& s, const std::vector<Sample>& samples, bool last) {
+    std::fprintf(out, "  \"%s\": {\"mean\": %.1f, \"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f, \"worst_position\": \"%s\"}%s\n",
+        name, s.mean, s.p50, s.p99, s.max, samples.empty() ? "" : samples[s.worst].cells.c_str(), last ? "" : ",");
+}
+
+/**
+ * @brief Main function of the benchmark.
+ * @param argc Number of arguments.
+ * @param argv Optional output file and number of repetitions per position.
+ * @return 0 on success, 1 if the output file cannot be written.
+ */
+int main(int argc, char* argv[]) {
+    const char* outputPath = argc > 1 ? argv[1] : "bench_results.json";
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (repetitions < 1) repetitions = 1;
+
+    std::vector<std::string> positions;
+    std::vector<bool> seen(19683, false);
+    std::string empty(9, ' ');
+    collectPositions(empty, false, seen, positions);
+    collectPositions(empty, true, seen, positions);
+
+    std::vector<Sample> samples;
+    volatile int sink = 0;
+    for (size_t p = 0; p < positions.size(); p++) {
+        Sample sample;
+        sample.cells = positions[p];
+        loadBoard(sample.cells);
+
+        resetSearchStats();
+        Pair move = findBestMove(board);
+        sample.nodes = searchStats.nodes;
+        sink += move.first;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repetitions; r++) sink += findBestMove(board).second;
+        auto middle = std::chrono::steady_clock::now();
+        BitBoard b = toBitBoard(board);
+        for (int r = 0; r < repetitions; r++) sink += lookupBestMove(b);
+        auto end = std::chrono::steady_clock::now();
+
+        sample.searchNs = std::chrono::duration<double, std::nano>(middle - start).count() / repetitions;
+        sample.lookupNs = std::chrono::duration<double, std::nano>(end - middle).count() / repetitions;
+        samples.push_back(sample);
+    }
+
+    Summary search = summarize(samples, &Sample::searchNs);
+    Summary lookup = summarize(samples, &Sample::lookupNs);
+    Summary nodes = summarize(samples, &Sample::nodes);
+
+    std::printf("positions: %zu (repetitions %d)\n", samples.size(), repetitions);
+    std::printf("findBestMove ns: mean %.1f p50 %.1f p99 %.1f max %.1f (%s)\n",
+        search.mean, search.p50, search.p99, search.max, samples[search.worst].cells.c_str());
+    std::printf("table lookup ns: mean %.1f p50 %.1f p99 %.1f max %.1f\n", lookup.mean, lookup.p50, lookup.p99, lookup.max);
+    std::printf("minimax nodes per move: mean %.2f max %.0f\n", nodes.mean, nodes.max);
+
+    FILE* out = std::fopen(outputPath, "w");
+    if (out == NULL) {
+        std::fprintf(stderr, "Failed to open %s\n", outputPath);
+        return 1;
+    }
+    std::fprintf(out, "{\n  \"positions\": %zu,\n  \"repetitions\": %d,\n", samples.size(), repetitions);
+    writeSummary(out, "findBestMove_ns", search, samples, false);
+    writeSummary(out, "table_lookup_ns", lookup, samples, false);
+    writeSummary(out, "nodes_per_move", nodes, samples, false);
+    std::fprintf(out, "  \"samples\": [\n");
+    for (size_t i = 0; i < samples.size(); i++) {
+        std::fprintf(out, "    {\"position\": \"%s\", \"findBestMove_ns\": %.1f, \"table_lookup_ns\": %.1f, \"nodes\": %u}%s\n",
+            samples[i].cells.c_str(), samples[i].searchNs, samples[i].lookupNs, (unsigned)samples[i].nodes,
+            i + 1 < samples.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+    std::printf("results written to %s\n", outputPath);
+    return 0;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file firmware_test.cpp
+ * @brief Runs the firmware AUnit tests (test.ino) on the host against the Arduino shim.
+ */
+
+#define TASK3_UNIT_TESTS
+#include "task3.ino"
+#include "test.ino"
+
+/**
+ * @brief Main function of the host test runner.
+ * @return Number of failed tests.
+ */
+int main() {
+    aunit::TestRunner::run();
+    return aunit::TestRunner::failures();
+}
@@ -0,0 +1,180 @@
+/**
+ * @file game_stats.cpp
+ * @brief Analytics over the client's binary game log (see lib/client/GameLog.h).
+ *
+ * The log is memory-mapped and its fixed-size records are read in place, so
+ * millions of games are summarised in one pass without parsing or copying.
+ * Prints, per mode, the results, average game length, duration and move
+ * round trip, and per opening move the win rate of the side that opened.
+ * Usage: game_stats <games.log>
+ */
+
+#include "GameLog.h"
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    MappedFile() : data(NULL), size(0) {}
+    ~MappedFile() { unmap(); }
+
+    /// @return False if the file cannot be opened or mapped.
+    bool map(const char* path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER length;
+        GetFileSizeEx(file, &length);
+        size = (size_t)length.QuadPart;
+        HANDLE mapping = size > 0 ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+        CloseHandle(file);
+        if (mapping == NULL) return false;
+        data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        return data != NULL;
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        size = (size_t)info.st_size;
+        void* view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED) return false;
+        madvise(view, size, MADV_SEQUENTIAL);
+        data = (const uint8_t*)view;
+        return true;
+#endif
+    }
+
+    const uint8_t* data;
+    size_t size;
+
+private:
+    void unmap() {
+        if (data == NULL) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap((void*)data, size);
+#endif
+        data = NULL;
+    }
+};
+
+/**
+ * @struct ModeSummary
+ * @brief Totals of one GameMode.
+ */
+struct ModeSummary {
+    uint64_t games = 0;
+    uint64_t results[6] = {};     ///< Games by GameStatus.
+    uint64_t moves = 0;
+    uint64_t durationMs = 0;
+    uint64_t latencyUs = 0;
+    uint64_t latencyMoves = 0;
+    uint64_t openings[9] = {};    ///< Games by first move.
+    uint64_t openerWins[9] = {};  ///< Of those, won by the side that opened.
+    uint64_t openerLosses[9] = {};
+};
+
+/// Names of GameMode values.
+const char* const MODE_NAMES[3] = {"player", "ai", "pvp"};
+
+/**
+ * @brief Main function of the report.
+ * @param argc Number of arguments.
+ * @param argv Path of the log.
+ * @return 0 on success, 1 if the log cannot be read.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <games.log>\n", argv[0]);
+        return 1;
+    }
+    MappedFile log;
+    if (!log.map(argv[1]) || log.size < sizeof(GameLogHeader)) {
+        std::fprintf(stderr, "cannot map %s\n", argv[1]);
+        return 1;
+    }
+    const GameLogHeader* header = (const GameLogHeader*)log.data;
+    if (memcmp(header->magic, "TTTL", 4) != 0 || header->version != GAME_LOG_VERSION
+        || header->recordSize != sizeof(GameRecord)) {
+        std::fprintf(stderr, "%s is not a version %u game log\n", argv[1], GAME_LOG_VERSION);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const GameRecord* records = (const GameRecord*)(log.data + sizeof(GameLogHeader));
+    size_t count = (log.size - sizeof(GameLogHeader)) / sizeof(GameRecord);
+    ModeSummary modes[3];
+    uint64_t skipped = 0;
+    for (size_t i = 0; i < count; i++) {
+        const GameRecord& r = records[i];
+        if (!r.valid() || r.mode > MODE_PVP || r.result > STATUS_DRAW) {
+            skipped++;
+            continue;
+        }
+        ModeSummary& m = modes[r.mode];
+        m.games++;
+        m.results[r.result]++;
+        m.moves += r.moveCount;
+        m.durationMs += r.durationMs;
+        m.latencyUs += r.latencyUs;
+        m.latencyMoves += r.latencyCount;
+        if (r.moveCount == 0) continue;
+        uint8_t opening = r.move(0);
+        if (opening > 8) continue;
+        // The human opens in "player", the AI in "ai" and X in "pvp".
+        uint8_t openerWin = r.mode == MODE_PLAYER ? STATUS_PLAYER_WIN : r.mode == MODE_AI ? STATUS_AI_WIN : STATUS_X_WIN;
+        uint8_t openerLoss = r.mode == MODE_PLAYER ? STATUS_AI_WIN : r.mode == MODE_AI ? STATUS_PLAYER_WIN : STATUS_O_WIN;
+        m.openings[opening]++;
+        if (r.result == openerWin) m.openerWins[opening]++;
+        if (r.result == openerLoss) m.openerLosses[opening]++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int mode = 0; mode < 3; mode++) {
+        const ModeSummary& m = modes[mode];
+        if (m.games == 0) continue;
+        double n = (double)m.games;
+        std::printf("%s: %llu games, avg %.2f moves, %.1f s, move round trip %.1f ms\n", MODE_NAMES[mode],
+            (unsigned long long)m.games, m.moves / n, m.durationMs / n / 1000.0,
+            m.latencyMoves > 0 ? m.latencyUs / (double)m.latencyMoves / 1000.0 : 0.0);
+        std::printf("  results:");
+        for (int status = STATUS_X_WIN; status <= STATUS_DRAW; status++) {
+            if (m.results[status] > 0) {
+                std::printf(" %s %.1f%%", statusText((GameStatus)status), 100.0 * m.results[status] / n);
+            }
+        }
+        std::printf("\n  opening  games   opener win%%  draw%%  opener loss%%\n");
+        for (int cell = 0; cell < 9; cell++) {
+            uint64_t games = m.openings[cell];
+            if (games == 0) continue;
+            std::printf("  %d,%d   %8llu   %10.1f %6.1f %13.1f\n", cell / 3, cell % 3, (unsigned long long)games,
+                100.0 * m.openerWins[cell] / games,
+                100.0 * (games - m.openerWins[cell] - m.openerLosses[cell]) / games,
+                100.0 * m.openerLosses[cell] / games);
+        }
+    }
+    std::printf("%zu records (%llu skipped) in %.3f s: %.1f M records/s\n", count,
+        (unsigned long long)skipped, seconds, seconds > 0 ? count / seconds / 1e6 : 0.0);
+    return 0;
+}
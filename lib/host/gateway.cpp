@@ -0,0 +1,91 @@
+/**
+ * @file gateway.cpp
+ * @brief Network gateway to the Tic-Tac-Toe game for many clients (Linux, see Gateway.h).
+ *
+ * With "engine" the games run in this process on the firmware logic of
+ * task3.ino: each client keeps its game as a PackedGame, which is loaded
+ * into the firmware globals for one command and packed back afterwards, the
+ * way the board runs its "@<id>" sessions. With a device path the games run
+ * on the board behind it, one firmware session per client.
+ * Usage: gateway <unix:/path | [host:]port> [engine | <device> [baud] [sessions]]
+ */
+
+#include "task3.ino"
+#include "Gateway.h"
+
+#include <csignal>
+
+/// Cleared by SIGINT/SIGTERM.
+volatile int running = 1;
+
+void stopRunning(int) { running = 0; }
+
+/**
+ * @class EngineBackend
+ * @brief Plays every client's game on the in-process firmware.
+ */
+class EngineBackend : public GameBackend {
+public:
+    bool attach(GatewayClient& client) {
+        client.game = PackedGame();
+        client.game.xToMove = 1;
+        return true;
+    }
+
+    void detach(GatewayClient&) {}
+
+    void submit(GatewayClient& client, const std::string& command) {
+        loadGame(client.game);
+        strncpy(receivedData, command.c_str(), sizeof(receivedData) - 1);
+        processCommand();
+        saveGame(client.game);
+        gateway->deliver(client, Serial.takeOutput());
+    }
+};
+
+/**
+ * @brief Main function of the gateway.
+ * @param argc Number of arguments.
+ * @param argv Listen address, backend, and for a board its baud rate and session count.
+ * @return 0 on a clean stop, 1 if the address or the board cannot be opened.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <unix:/path | [host:]port> [engine | <device> [baud] [sessions]]\n", argv[0]);
+        return 1;
+    }
+    SocketAddress address;
+    if (!address.parse(argv[1])) {
+        std::fprintf(stderr, "bad address %s\n", argv[1]);
+        return 1;
+    }
+    const char* device = argc > 2 && strcmp(argv[2], "engine") != 0 ? argv[2] : NULL;
+    unsigned long baud = argc > 3 ? strtoul(argv[3], NULL, 10) : 9600;
+    int slots = argc > 4 ? atoi(argv[4]) : SESSION_SLOTS;
+
+    EngineBackend engine;
+    PosixSerialPort port;
+    if (device != NULL && !port.open(device, baud)) {
+        std::fprintf(stderr, "cannot open %s at %lu baud\n", device, baud);
+        return 1;
+    }
+    SerialBackend board(port, (uint8_t)(slots < 1 ? 1 : slots > 255 ? 255 : slots));
+    GameBackend& backend = device != NULL ? (GameBackend&)board : (GameBackend&)engine;
+
+    setup();
+    Serial.takeOutput();
+    Gateway gateway(backend);
+    if (!gateway.open(address)) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    std::signal(SIGINT, stopRunning);
+    std::signal(SIGTERM, stopRunning);
+    std::printf("gateway on %s, games on %s\n", argv[1], device != NULL ? device : "the in-process engine");
+    std::fflush(stdout);
+
+    gateway.run(&running);
+    gateway.report();
+    if (address.unixSocket) unlink(address.path.c_str());
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file gateway_load.cpp
+ * @brief Load generator for lib/host/gateway (Linux).
+ *
+ * Opens the given number of connections at once and plays random games as
+ * "player first" on every one of them: "reset", "player", then random free
+ * cells until the game ends. Each connection has one command in flight;
+ * the time from sending a move to receiving its board is the move latency.
+ * Reports the connections served, moves per second and the latency
+ * percentiles.
+ * Usage: gateway_load <unix:/path | [host:]port> [connections] [games per connection]
+ */
+
+#include "Gateway.h"
+
+#include <algorithm>
+#include <random>
+
+/// Longest wait for any reply before the run is abandoned.
+const int IDLE_TIMEOUT_MS = 5000;
+
+/**
+ * @struct LoadClient
+ * @brief One connection of the load generator.
+ */
+struct LoadClient {
+    int fd;
+    std::string input;           ///< Partial reply line.
+    char cells[9];               ///< Board from the last reply.
+    int step;                    ///< 0 reset sent, 1 player sent, 2 move sent.
+    int games;                   ///< Games finished.
+    bool done;
+    GatewayClock::time_point sent;
+};
+
+/**
+ * @brief Sends one command line; the socket buffer always has room for it.
+ */
+void sendLine(LoadClient& client, const char* command) {
+    std::string line = std::string(command) + "\n";
+    send(client.fd, line.data(), line.size(), MSG_NOSIGNAL);
+    client.sent = GatewayClock::now();
+}
+
+/**
+ * @brief Main function of the load generator.
+ * @param argc Number of arguments.
+ * @param argv Gateway address, number of connections and games per connection.
+ * @return 0 if every connection finished its games, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <unix:/path | [host:]port> [connections] [games per connection]\n", argv[0]);
+        return 1;
+    }
+    SocketAddress address;
+    if (!address.parse(argv[1])) {
+        std::fprintf(stderr, "bad address %s\n", argv[1]);
+        return 1;
+    }
+    int connections = argc > 2 ? atoi(argv[2]) : 100;
+    int games = argc > 3 ? atoi(argv[3]) : 10;
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    std::vector<LoadClient> clients;
+    clients.reserve(connections);
+    int failed = 0;
+    for (int i = 0; i < connections; i++) {
+        int fd = connectTo(address);
+        if (fd < 0) {
+            failed++;
+            continue;
+        }
+        LoadClient client = {fd, std::string(), {0}, 0, 0, false, GatewayClock::time_point()};
+        clients.push_back(client);
+    }
+    for (size_t i = 0; i < clients.size(); i++) {
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = i;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, clients[i].fd, &event);
+    }
+
+    std::mt19937 rng(2425);
+    std::vector<double> latencies;
+    latencies.reserve((size_t)connections * games * 5);
+    size_t active = clients.size();
+    int rejected = 0;
+    int lost = 0;
+    GatewayClock::time_point start = GatewayClock::now();
+    for (size_t i = 0; i < clients.size(); i++) sendLine(clients[i], "reset");
+
+    epoll_event events[256];
+    while (active > 0) {
+        int count = epoll_wait(epoll, events, 256, IDLE_TIMEOUT_MS);
+        if (count <= 0) {
+            std::fprintf(stderr, "no reply for %d ms, %zu connections still playing\n", IDLE_TIMEOUT_MS, active);
+            break;
+        }
+        for (int e = 0; e < count; e++) {
+            LoadClient& client = clients[events[e].data.u64];
+            char buffer[4096];
+            ssize_t received = read(client.fd, buffer, sizeof(buffer));
+            if (received <= 0) {
+                if (received < 0 && errno == EAGAIN) continue;
+                lost++;
+                client.done = true;
+                active--;
+                epoll_ctl(epoll, EPOLL_CTL_DEL, client.fd, NULL);
+                continue;
+            }
+            client.input.append(buffer, (size_t)received);
+            size_t newline;
+            while (!client.done && (newline = client.input.find('\n')) != std::string::npos) {
+                std::string line = client.input.substr(0, newline);
+                client.input.erase(0, newline + 1);
+                if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+                if (line == "Error: Server busy!") {
+                    rejected++;
+                    client.done = true;
+                    active--;
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, client.fd, NULL);
+                    break;
+                }
+                if (!isBoardLine(line)) continue; // result line after the last board
+                memcpy(client.cells, line.data(), 9);
+                if (client.step == 2) {
+                    latencies.push_back(std::chrono::duration<double, std::milli>(GatewayClock::now() - client.sent).count());
+                }
+                if (client.step == 0) {
+                    client.step = 1;
+                    sendLine(client, "player");
+                    continue;
+                }
+                if (boardFinished(client.cells)) {
+                    if (++client.games == games) {
+                        client.done = true;
+                        active--;
+                        epoll_ctl(epoll, EPOLL_CTL_DEL, client.fd, NULL);
+                        break;
+                    }
+                    client.step = 0;
+                    sendLine(client, "reset");
+                    continue;
+                }
+                int free[9];
+                int options = 0;
+                for (int cell = 0; cell < 9; cell++) {
+                    if (client.cells[cell] == ' ') free[options++] = cell;
+                }
+                int cell = free[rng() % options];
+                char move[4] = {(char)('0' + cell / 3), ',', (char)('0' + cell % 3), '\0'};
+                client.step = 2;
+                sendLine(client, move);
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(GatewayClock::now() - start).count();
+
+    int finished = 0;
+    for (size_t i = 0; i < clients.size(); i++) {
+        if (clients[i].games == games) finished++;
+        close(clients[i].fd);
+    }
+    close(epoll);
+    std::printf("connections: %d requested, %d served to the end, %d rejected, %d failed to connect, %d lost\n",
+        connections, finished, rejected, failed, lost);
+    if (latencies.empty()) return 1;
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0;
+    for (size_t i = 0; i < latencies.size(); i++) sum += latencies[i];
+    std::printf("%zu moves in %.2f s: %.0f moves/s\n", latencies.size(), seconds, latencies.size() / seconds);
+    std::printf("move round trip ms: mean %.3f p50 %.3f p99 %.3f max %.3f\n",
+        sum / latencies.size(), latencies[latencies.size() / 2],
+        latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)], latencies.back());
+    return finished == connections ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file gen_move_table.cpp
+ * @brief Host tool that generates MoveTable.h for the Arduino firmware.
+ *
+ * Runs the firmware AI (bbFindBestMove) on every position in which the AI is
+ * to move and stores the chosen cell, two moves per byte, in a PROGMEM array.
+ * The same positions are then searched to the end by BoardSearch<3, 3>,
+ * without and with the transposition table, and the node counts of both
+ * passes are printed to stderr.
+ * Usage: gen_move_table [output file]  (writes to stdout by default).
+ */
+
+#include <cstdio>
+#include <vector>
+#include "BitBoard.h"
+#include "BoardSearch.h"
+#include "PositionIndex.h"
+#include "Search.h"
+
+/**
+ * @brief Searches every indexed position with BoardSearch<3, 3>, without and with the transposition table.
+ * @param positions Positions with the AI to move.
+ * @return False if the table changed a move.
+ */
+bool measureTranspositionTable(const std::vector<BitBoard>& positions) {
+    BoardSearch<3, 3> search;
+    std::vector<int> moves(positions.size());
+    unsigned long nodes[2] = {0, 0};
+    for (int pass = 0; pass < 2; pass++) {
+        ttEnabled = (pass == 1);
+        resetSearchStats();
+        for (size_t i = 0; i < positions.size(); i++) {
+            char cells[9];
+            for (int cell = 0; cell < 9; cell++) {
+                cells[cell] = (positions[i].ai >> cell & 1) ? 'O' : (positions[i].player >> cell & 1) ? 'X' : ' ';
+            }
+            Board<3, 3> board;
+            board.load(cells, MARK_O);
+            search.clearHistory();
+            SearchResult result = search.findBestMove(board, DEFAULT_SEARCH);
+            nodes[pass] += result.nodes;
+            if (pass == 0) {
+                moves[i] = result.move;
+            } else if (moves[i] != result.move) {
+                std::fprintf(stderr, "Transposition table changed the move at index %zu\n", i);
+                return false;
+            }
+        }
+    }
+    std::fprintf(stderr, "Alpha-beta nodes: %lu without TT, %lu with TT (%d entries, %lu probes, %lu hits)\n",
+        nodes[0], nodes[1], TT_SIZE, (unsigned long)searchStats.ttProbes, (unsigned long)searchStats.ttHits);
+    return true;
+}
+
+/**
+ * @brief Main function of the generator.
+ * @param argc Number of arguments.
+ * @param argv argv[1] is the optional output file.
+ * @return 0 on success, 1 if the index is not a bijection or the file cannot be written.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<int> moves(INDEXED_POSITIONS, -2);
+    std::vector<BitBoard> positions;
+
+    resetSearchStats();
+    for (int code = 0; code < 19683; code++) {
+        BitBoard b = {0, 0};
+        int rest = code;
+        for (int cell = 0; cell < 9; cell++, rest /= 3) {
+            if (rest % 3 == 1) b.ai |= 1 << cell;
+            if (rest % 3 == 2) b.player |= 1 << cell;
+        }
+        int index = positionIndex(b);
+        if (index < 0) continue;
+        if (index >= INDEXED_POSITIONS || moves[index] != -2) {
+            std::fprintf(stderr, "Index collision at position %d\n", code);
+            return 1;
+        }
+        moves[index] = bbFindBestMove(b);
+        positions.push_back(b);
+    }
+    std::fprintf(stderr, "Minimax nodes: %lu\n", (unsigned long)searchStats.nodes);
+    if (!measureTranspositionTable(positions)) return 1;
+    for (int i = 0; i < INDEXED_POSITIONS; i++) {
+        if (moves[i] == -2) {
+            std::fprintf(stderr, "Index %d is never reached\n", i);
+            return 1;
+        }
+    }
+
+    FILE* out = argc > 1 ? std::fopen(argv[1], "w") : stdout;
+    if (out == NULL) {
+        std::fprintf(stderr, "Failed to open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::fprintf(out, "/**\n");
+    std::fprintf(out, " * @file MoveTable.h\n");
+    std::fprintf(out, " * @brief AI reply for every position indexed by positionIndex().\n");
+    std::fprintf(out, " *\n");
+    std::fprintf(out, " * Generated by lib/host/gen_move_table.cpp (make movetable), do not edit.\n");
+    std::fprintf(out, " * Entry i is stored in the low nibble of byte i / 2 when i is even and in\n");
+    std::fprintf(out, " * the high nibble otherwise; NO_TABLE_MOVE marks positions without a move.\n");
+    std::fprintf(out, " */\n");
+    std::fprintf(out, "#ifndef MOVE_TABLE_H\n#define MOVE_TABLE_H\n\n");
+    std::fprintf(out, "#include \"PositionIndex.h\"\n\n");
+    std::fprintf(out, "/// Packed best moves, two cells per byte.\n");
+    std::fprintf(out, "const uint8_t MOVE_TABLE[%d] PROGMEM = {", (INDEXED_POSITIONS + 1) / 2);
+    for (int i = 0; i < INDEXED_POSITIONS; i += 2) {
+        int low = moves[i] < 0 ? NO_TABLE_MOVE : moves[i];
+        int high = (i + 1 < INDEXED_POSITIONS && moves[i + 1] >= 0) ? moves[i + 1] : NO_TABLE_MOVE;
+        std::fprintf(out, "%s0x%02X", (i % 32 == 0) ? "\n    " : ", ", (high << 4) | low);
+        if (i + 2 < INDEXED_POSITIONS) std::fprintf(out, "%s", (i % 32 == 30) ? "," : "");
+    }
+    std::fprintf(out, "\n};\n\n#endif // MOVE_TABLE_H\n");
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
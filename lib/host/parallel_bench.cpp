@@ -0,0 +1,73 @@
+/**
+ * @file parallel_bench.cpp
+ * @brief Compares the single-threaded BoardSearch with ParallelSearch on 15 x 15 gomoku.
+ *
+ * Every position is searched to the same fixed depth by BoardSearch, by
+ * ParallelSearch with one thread and by ParallelSearch with the requested
+ * number of threads. Prints nodes, time, nodes/second and the speedup of
+ * the parallel search over BoardSearch.
+ * Usage: parallel_bench [threads] [depth]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "BoardSearch.h"
+#include "ParallelSearch.h"
+
+/// Board used by the benchmark.
+typedef Board<15, 5> Gomoku;
+
+/// Opening positions, as row-major lists of cells ending with -1 (X moves first).
+const int OPENINGS[][8] = {
+    {112, -1},
+    {112, 113, 97, -1},
+    {112, 96, 128, 98, 113, -1},
+    {112, 127, 111, 113, 96, 126, 98, -1}
+};
+
+/**
+ * @brief Main function of the benchmark.
+ * @param argc Number of arguments.
+ * @param argv Optional thread count and search depth.
+ * @return 0 on success.
+ */
+int main(int argc, char* argv[]) {
+    unsigned threads = argc > 1 ? (unsigned)std::atoi(argv[1]) : 0;
+    int depth = argc > 2 ? std::atoi(argv[2]) : 4;
+    SearchLimits limits = {(uint8_t)depth, 0, 0};
+
+    ParallelSearch<15, 5> single(1);
+    ParallelSearch<15, 5> parallel(threads);
+    std::printf("threads=%u depth=%d\n", parallel.threadCount(), depth);
+    std::printf("%-4s %-14s %12s %10s %12s %6s\n", "pos", "engine", "nodes", "seconds", "nodes/s", "move");
+
+    double totalSequential = 0;
+    double totalParallel = 0;
+    for (size_t p = 0; p < sizeof(OPENINGS) / sizeof(OPENINGS[0]); p++) {
+        Gomoku board;
+        for (int i = 0; OPENINGS[p][i] >= 0; i++) board.place((uint8_t)OPENINGS[p][i]);
+
+        BoardSearch<15, 5> sequential;
+        auto start = std::chrono::steady_clock::now();
+        SearchResult result = sequential.findBestMove(board, limits);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-4zu %-14s %12lu %10.3f %12.0f %6d\n", p, "BoardSearch",
+            (unsigned long)result.nodes, seconds, seconds > 0 ? result.nodes / seconds : 0.0, result.move);
+        totalSequential += seconds;
+
+        ParallelSearch<15, 5>* engines[2] = {&single, &parallel};
+        const char* names[2] = {"Parallel x1", "Parallel xN"};
+        for (int e = 0; e < 2; e++) {
+            result = engines[e]->findBestMove(board, limits);
+            const ParallelStats& stats = engines[e]->stats();
+            std::printf("%-4zu %-14s %12llu %10.3f %12.0f %6d  steals=%llu splits=%llu tt=%llu\n", p, names[e],
+                (unsigned long long)stats.nodes, stats.seconds, stats.nodesPerSecond(), result.move,
+                (unsigned long long)stats.steals, (unsigned long long)stats.splits, (unsigned long long)stats.ttHits);
+            if (e == 1) totalParallel += stats.seconds;
+        }
+    }
+    std::printf("speedup vs BoardSearch: %.2fx (%.3f s -> %.3f s)\n",
+        totalParallel > 0 ? totalSequential / totalParallel : 0.0, totalSequential, totalParallel);
+    return 0;
+}
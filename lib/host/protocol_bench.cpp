@@ -0,0 +1,126 @@
+/**
+ * @file protocol_bench.cpp
+ * @brief Compares the text and the binary serial protocol of the firmware.
+ *
+ * Plays the same random games (player first, AI first and PvP) through the
+ * firmware's loop() once with text commands and once with binary frames,
+ * counts the bytes sent and received per move and converts them into the
+ * wire part of the round trip at the client's and the firmware's baud rate
+ * (10 bits per byte: start, 8 data, stop).
+ * Usage: protocol_bench [games per mode]
+ */
+
+#include "task3.ino"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+/**
+ * @struct Traffic
+ * @brief Byte counts of one protocol.
+ */
+struct Traffic {
+    unsigned long moves = 0;    ///< Human moves played.
+    unsigned long sent = 0;     ///< Bytes client -> firmware for those moves.
+    unsigned long received = 0; ///< Bytes firmware -> client for those moves.
+};
+
+/**
+ * @brief Feeds bytes to the firmware and runs loop() until they are consumed.
+ * @param data Bytes to send.
+ * @return Number of bytes the firmware replied with.
+ */
+size_t exchange(const std::string& data) {
+    Serial.feed(data);
+    while (Serial.available() > 0) loop();
+    return Serial.takeOutput().size();
+}
+
+/**
+ * @brief Encodes a binary command.
+ * @param opcode Frame type.
+ * @param seq Sequence number.
+ * @param p0 First payload byte.
+ * @return The frame bytes.
+ */
+std::string frameBytes(uint8_t opcode, uint8_t seq, uint8_t p0) {
+    uint8_t bytes[FRAME_SIZE];
+    encodeFrame(makeFrame(opcode, seq, p0), bytes);
+    return std::string((const char*)bytes, FRAME_SIZE);
+}
+
+/**
+ * @brief Plays games with random human moves and counts the move traffic.
+ * @param binary Use binary frames instead of text commands.
+ * @param games Games per mode.
+ * @param seed Seed of the move generator, equal for both protocols.
+ * @return The byte counts.
+ */
+Traffic playGames(bool binary, int games, unsigned seed) {
+    static const char* const MODE_NAMES[] = {"player", "ai", "pvp"};
+    std::mt19937 rng(seed);
+    Traffic traffic;
+    uint8_t seq = 0;
+    for (int mode = MODE_PLAYER; mode <= MODE_PVP; mode++) {
+        for (int game = 0; game < games; game++) {
+            if (binary) {
+                exchange(frameBytes(OP_RESET, seq++, 0));
+                exchange(frameBytes(OP_MODE, seq++, (uint8_t)mode));
+            } else {
+                exchange("reset\n");
+                exchange(std::string(MODE_NAMES[mode]) + "\n");
+            }
+            while (!gameOver) {
+                int free[9], count = 0;
+                for (int cell = 0; cell < 9; cell++) {
+                    if (board[cell / 3][cell % 3] == ' ') free[count++] = cell;
+                }
+                if (count == 0) break;
+                int cell = free[rng() % count];
+                std::string command = binary ? frameBytes(OP_MOVE, seq++, (uint8_t)cell)
+                    : std::string(1, (char)('0' + cell / 3)) + "," + (char)('0' + cell % 3) + "\n";
+                traffic.sent += command.size();
+                traffic.received += exchange(command);
+                traffic.moves++;
+            }
+        }
+    }
+    return traffic;
+}
+
+/**
+ * @brief Prints one protocol's figures.
+ */
+void report(const char* name, const Traffic& t) {
+    double sent = (double)t.sent / t.moves;
+    double received = (double)t.received / t.moves;
+    double bits = (sent + received) * 10;
+    std::printf("%-7s %8.2f %8.2f %8.2f %10.2f %10.2f\n", name, sent, received, sent + received,
+        bits * 1000 / 4800, bits * 1000 / 9600);
+}
+
+/**
+ * @brief Main function of the protocol comparison.
+ * @param argc Number of arguments.
+ * @param argv Optional number of games per mode.
+ * @return 0.
+ */
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (games < 1) games = 1;
+    setup();
+    Serial.takeOutput();
+
+    Traffic text = playGames(false, games, 2425);
+    exchange("bin\n");
+    Traffic binary = playGames(true, games, 2425);
+
+    std::printf("%d games per mode, %lu moves\n", games, text.moves);
+    std::printf("%-7s %8s %8s %8s %10s %10s\n", "", "tx B/mv", "rx B/mv", "total", "ms @4800", "ms @9600");
+    report("text", text);
+    report("binary", binary);
+    std::printf("binary saves %.1f%% of the bytes per move\n",
+        100.0 * (1.0 - (double)(binary.sent + binary.received) / (text.sent + text.received)));
+    return 0;
+}
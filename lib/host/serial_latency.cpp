@@ -0,0 +1,211 @@
+/**
+ * @file serial_latency.cpp
+ * @brief End-to-end latency and load test of the client's serial path (Linux/macOS).
+ *
+ * Drives the client's SerialWorker over PosixSerialPort, exactly as the UI
+ * does, against a real board or lib/host/virtual_arduino. Plays random games
+ * as "player first" and reports the time from queuing a move to receiving
+ * its board, plus moves and games per second, and the client's per-stage
+ * breakdown of the round trip (LatencyTrace.h). Every move is also predicted
+ * with the client's MovePredictor, so the run shows how often the board's
+ * reply would have been rolled back in the UI. Replies are awaited on a
+ * UiWakeup like the UI does; at the end the client's threads sit idle for
+ * IDLE_TIME the way the UI loop does between inputs, and their CPU use is
+ * reported. With a maximum rate the worker first negotiates the link speed
+ * (Link.h) as the client does with [Serial] MaxBaud.
+ * Usage: serial_latency <device> [games] [baud] [binary 0/1] [max baud]
+ */
+
+#include "SerialWorker.h"
+#include "MovePredictor.h"
+#include "BitBoard.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include <sys/resource.h>
+
+typedef std::chrono::steady_clock Clock;
+
+/// Longest wait for one reply.
+const std::chrono::milliseconds REPLY_TIMEOUT(3000);
+/// Silence that ends the start-up output of the board.
+const std::chrono::milliseconds QUIET_TIME(300);
+/// Idle time measured after the games.
+const std::chrono::milliseconds IDLE_TIME(2000);
+
+UiWakeup wakeup; ///< Signaled by the worker after every message.
+
+/**
+ * @brief Sleeps on the wakeup until the deadline at the latest.
+ */
+void sleepUntil(Clock::time_point deadline) {
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    if (ms > 0) wakeup.wait((int)ms);
+}
+
+/**
+ * @return CPU time of the process (all threads) in seconds.
+ */
+double cpuSeconds() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+/**
+ * @brief Waits for the next message of one of two kinds; others are skipped.
+ * @return False on timeout.
+ */
+bool waitFor(SerialWorker& worker, SerialMessage::Kind kind, SerialMessage::Kind other, SerialMessage& message) {
+    Clock::time_point deadline = Clock::now() + REPLY_TIMEOUT;
+    while (Clock::now() < deadline) {
+        if (!worker.poll(message)) {
+            sleepUntil(deadline);
+        } else if (message.kind == kind || message.kind == other || message.kind == SerialMessage::NACK) {
+            return message.kind != SerialMessage::NACK;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Packs the client's view of the board, 'O' being the AI.
+ */
+BitBoard toBitBoard(const char* cells) {
+    BitBoard b = {0, 0};
+    for (int i = 0; i < 9; i++) {
+        if (cells[i] == 'O') b.ai |= (uint16_t)1 << i;
+        if (cells[i] == 'X') b.player |= (uint16_t)1 << i;
+    }
+    return b;
+}
+
+/**
+ * @brief Main function of the latency test.
+ * @param argc Number of arguments.
+ * @param argv Device, number of games, baud rate, protocol, the fastest rate to negotiate and the AI tier.
+ * @return 0 on success, 1 if the port cannot be opened or the Arduino stops answering.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <device> [games] [baud] [binary 0/1] [max baud] [tier 0-2]\n", argv[0]);
+        return 1;
+    }
+    int games = argc > 2 ? std::atoi(argv[2]) : 50;
+    unsigned long baud = argc > 3 ? std::strtoul(argv[3], NULL, 10) : 9600;
+    bool binary = argc > 4 && std::atoi(argv[4]) != 0;
+    unsigned long maxBaud = argc > 5 ? std::strtoul(argv[5], NULL, 10) : 0;
+    uint8_t tier = argc > 6 ? (uint8_t)std::atoi(argv[6]) : (uint8_t)TIER_NORMAL;
+    if (tier >= AI_TIER_COUNT) {
+        std::fprintf(stderr, "unknown tier %d\n", tier);
+        return 1;
+    }
+
+    PosixSerialPort port;
+    if (!port.open(argv[1], baud)) {
+        std::fprintf(stderr, "cannot open %s at %lu baud\n", argv[1], baud);
+        return 1;
+    }
+    SerialWorker worker;
+    logSink().setLevel(LOG_WARN);
+    worker.setWakeup(&wakeup);
+    worker.setLinkRates(baud, maxBaud);
+    worker.start(port, binary);
+
+    // setup() prints a board before the first command; left in the queue it
+    // would be taken for the reply to the first reset and shift game 0. So
+    // reset once, and after the first board wait until the link is quiet.
+    SerialMessage message;
+    worker.send(OP_RESET, 0);
+    if (!waitFor(worker, SerialMessage::BOARD, SerialMessage::BOARD, message)) {
+        std::fprintf(stderr, "no board after the first reset\n");
+        return 1;
+    }
+    for (Clock::time_point quiet = Clock::now() + QUIET_TIME; Clock::now() < quiet;) {
+        if (worker.poll(message)) quiet = Clock::now() + QUIET_TIME;
+        else sleepUntil(quiet);
+    }
+
+    std::mt19937 rng(2425);
+    std::vector<double> latencies;
+    LatencyTrace trace;
+    MovePredictor predictor;
+    char shown[9];
+    char cells[9];
+    Clock::time_point start = Clock::now();
+    for (int game = 0; game < games; game++) {
+        worker.send(OP_RESET, 0);
+        worker.send(OP_MODE, MODE_PLAYER, tier);
+        if (!waitFor(worker, SerialMessage::BOARD, SerialMessage::BOARD, message)
+            || !waitFor(worker, SerialMessage::BOARD, SerialMessage::BOARD, message)) {
+            std::fprintf(stderr, "no board after reset (game %d)\n", game);
+            return 1;
+        }
+        memcpy(cells, message.cells, 9);
+        for (;;) {
+            BitBoard b = toBitBoard(cells);
+            uint16_t empty = bbEmpty(b);
+            if (bbEvaluate(b) != 0 || empty == 0) break;
+            int choice = (int)(rng() % bitCount(empty));
+            int cell = 0;
+            for (; cell < 9; cell++) {
+                if ((empty >> cell & 1) && choice-- == 0) break;
+            }
+
+            Clock::time_point sent = Clock::now();
+            worker.send(OP_MOVE, (uint8_t)cell);
+            if (MovePredictor::predictable(tier)) {
+                memcpy(shown, cells, 9);
+                predictor.predict(shown, cell, true);
+            }
+            if (!waitFor(worker, SerialMessage::BOARD, SerialMessage::DELTA, message)) {
+                std::fprintf(stderr, "no reply to move %d (game %d)\n", cell, game);
+                return 1;
+            }
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - sent).count());
+            trace.record(message.trace, Clock::now());
+            if (message.kind == SerialMessage::BOARD) {
+                memcpy(cells, message.cells, 9);
+            } else {
+                for (int m = 0; m < 2; m++) {
+                    if (message.delta[m] != NO_DELTA) cells[message.delta[m] & 0x0F] = (message.delta[m] >> 4) == 1 ? 'X' : 'O';
+                }
+            }
+            predictor.reconcile(cells);
+        }
+        if (!worker.binary()) {
+            // The text result line follows the board; wait for it before the next reset.
+            waitFor(worker, SerialMessage::STATUS, SerialMessage::STATUS, message);
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Idle like the UI between inputs: drain replies, sleep until the next one.
+    double cpuBefore = cpuSeconds();
+    Clock::time_point idleStart = Clock::now();
+    while (Clock::now() - idleStart < IDLE_TIME) {
+        while (worker.poll(message)) {}
+        wakeup.wait(UiWakeup::INPUT_WAIT_MS);
+    }
+    double idleCpu = (cpuSeconds() - cpuBefore) / std::chrono::duration<double>(Clock::now() - idleStart).count();
+    worker.stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0;
+    for (size_t i = 0; i < latencies.size(); i++) sum += latencies[i];
+    std::printf("%s protocol, %lu baud, %s AI: %d games, %zu moves in %.2f s\n",
+        worker.binary() ? "binary" : "text", worker.linkBaud(), AI_TIER_NAMES[tier], games, latencies.size(), seconds);
+    std::printf("move round trip ms: mean %.2f p50 %.2f p99 %.2f max %.2f\n",
+        sum / latencies.size(), latencies[latencies.size() / 2],
+        latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)], latencies.back());
+    std::printf("throughput: %.1f moves/s, %.2f games/s\n", latencies.size() / seconds, games / seconds);
+    std::printf("%s", worker.linkSummary().c_str());
+    std::printf("%s", trace.summary().c_str());
+    std::printf("%s", predictor.summary().c_str());
+    std::printf("idle: %.2f%% of a core (UI wait and serial thread)\n", idleCpu * 100);
+    return 0;
+}
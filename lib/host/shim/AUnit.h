@@ -0,0 +1,95 @@
+/**
+ * @file AUnit.h
+ * @brief Host stand-in for the AUnit test framework used by test.ino.
+ *
+ * test() registers a function, TestRunner::run() executes every registered
+ * test once and prints one line per test; later calls do nothing, matching
+ * the way loop() keeps calling it on the board.
+ */
+#ifndef HOST_AUNIT_H
+#define HOST_AUNIT_H
+
+#include <iostream>
+#include <vector>
+
+namespace aunit {
+
+/**
+ * @struct Verbosity
+ * @brief Verbosity flags accepted (and ignored) by TestRunner::setVerbosity().
+ */
+struct Verbosity {
+    enum { kNone = 0, kAll = 0xFF };
+};
+
+/**
+ * @class TestRunner
+ * @brief Runs the registered tests.
+ */
+class TestRunner {
+public:
+    typedef void (*TestFunction)(bool& failed);
+
+    struct Test {
+        const char* name;
+        TestFunction body;
+    };
+
+    static std::vector<Test>& tests() {
+        static std::vector<Test> registry;
+        return registry;
+    }
+
+    static int add(const char* name, TestFunction body) {
+        tests().push_back(Test{name, body});
+        return 0;
+    }
+
+    static void setVerbosity(int) {}
+
+    static void run() {
+        if (done()) return;
+        done() = true;
+        for (size_t i = 0; i < tests().size(); i++) {
+            bool failed = false;
+            tests()[i].body(failed);
+            if (failed) failures()++;
+            std::cout << "Test " << tests()[i].name << (failed ? " failed." : " passed.") << std::endl;
+        }
+        std::cout << "TestRunner summary: " << tests().size() - failures() << " passed, "
+                  << failures() << " failed." << std::endl;
+    }
+
+    /// @return Number of failed tests after run().
+    static int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+private:
+    static bool& done() {
+        static bool flag = false;
+        return flag;
+    }
+};
+
+} // namespace aunit
+
+#define test(name) \
+    static void aunitTest_##name(bool& aunitFailed); \
+    static int aunitRegistered_##name = aunit::TestRunner::add(#name, aunitTest_##name); \
+    static void aunitTest_##name(bool& aunitFailed)
+
+#define AUNIT_FAIL(expression) \
+    do { \
+        std::cout << __FILE__ << ":" << __LINE__ << ": Assertion failed: " << expression << std::endl; \
+        aunitFailed = true; \
+        return; \
+    } while (0)
+
+#define assertEqual(a, b) do { if (!((a) == (b))) AUNIT_FAIL(#a " == " #b); } while (0)
+#define assertNotEqual(a, b) do { if ((a) == (b)) AUNIT_FAIL(#a " != " #b); } while (0)
+#define assertTrue(a) do { if (!(a)) AUNIT_FAIL(#a " is true"); } while (0)
+#define assertFalse(a) do { if (a) AUNIT_FAIL(#a " is false"); } while (0)
+
+#endif // HOST_AUNIT_H
@@ -0,0 +1,48 @@
+/**
+ * @file Arduino.cpp
+ * @brief Definitions for the host Arduino shim.
+ */
+
+#include "Arduino.h"
+#include "EEPROM.h"
+
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+EEPROMClass EEPROM;
+uint8_t hostPinLevels[HOST_PIN_COUNT];
+uint8_t hostPinModes[HOST_PIN_COUNT];
+
+/// Time origin of millis() and micros().
+static const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < HOST_PIN_COUNT) hostPinModes[pin] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < HOST_PIN_COUNT) hostPinLevels[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < HOST_PIN_COUNT ? hostPinLevels[pin] : LOW;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino core for compiling the firmware sketch on the host.
+ *
+ * Provides the subset task3.ino uses: Serial, digital pins, millis()/micros(),
+ * delay() and the flash string helpers (F(), PSTR(), strcmp_P()), which are
+ * plain RAM strings here. Serial reads from an input buffer filled by the host program
+ * and collects everything the sketch prints in an output buffer.
+ */
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+#define PSTR(text) (text)
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef strcmp_P
+#define strcmp_P(text, flashText) strcmp((text), (flashText))
+#endif
+#ifndef strncmp_P
+#define strncmp_P(text, flashText, length) strncmp((text), (flashText), (length))
+#endif
+
+/// Number of emulated digital pins.
+const int HOST_PIN_COUNT = 20;
+
+/// Current level of every digital pin.
+extern uint8_t hostPinLevels[HOST_PIN_COUNT];
+
+/// Mode set by pinMode() for every digital pin.
+extern uint8_t hostPinModes[HOST_PIN_COUNT];
+
+template <class T> inline T min(T a, T b) { return a < b ? a : b; }
+template <class T> inline T max(T a, T b) { return a > b ? a : b; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+/**
+ * @class HostSerial
+ * @brief Buffer-backed stand-in for HardwareSerial.
+ */
+class HostSerial {
+public:
+    void begin(unsigned long baud) { baudRate = baud; beganAt = output.size(); }
+    void end() {}
+    operator bool() const { return true; }
+
+    int available() const { return (int)(input.size() - inputPos); }
+    int peek() const { return available() > 0 ? (uint8_t)input[inputPos] : -1; }
+    int read() { return available() > 0 ? (uint8_t)input[inputPos++] : -1; }
+    void flush() {}
+
+    size_t write(uint8_t c) { output.push_back((char)c); return 1; }
+    size_t write(const uint8_t* data, size_t size) { output.append((const char*)data, size); return size; }
+
+    size_t print(const char* s) { output += s; return strlen(s); }
+    size_t print(const __FlashStringHelper* s) { return print(reinterpret_cast<const char*>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n) { return printNumber((long)n); }
+    size_t print(unsigned int n) { return printNumber((unsigned long)n); }
+    size_t print(long n) { return printNumber(n); }
+    size_t print(unsigned long n) { return printNumber(n); }
+    size_t print(double n) { return printNumber(n); }
+
+    size_t println() { return print("\r\n"); }
+    template <class T> size_t println(T value) { size_t n = print(value); return n + println(); }
+
+    /// Appends bytes the sketch will read.
+    void feed(const std::string& data) { input.append(data); }
+    /// Returns and clears everything the sketch printed.
+    std::string takeOutput() { std::string out; out.swap(output); beganAt = 0; return out; }
+    /// Drops pending input and output.
+    void clearBuffers() { input.clear(); inputPos = 0; output.clear(); }
+
+    unsigned long baudRate = 0; ///< Rate passed to begin().
+    size_t beganAt = 0;         ///< Output bytes printed before the last begin(), since takeOutput().
+
+private:
+    size_t printNumber(long n) { std::string s = std::to_string(n); output += s; return s.size(); }
+    size_t printNumber(unsigned long n) { std::string s = std::to_string(n); output += s; return s.size(); }
+    size_t printNumber(double n) { std::string s = std::to_string(n); output += s; return s.size(); }
+
+    std::string input;
+    size_t inputPos = 0;
+    std::string output;
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
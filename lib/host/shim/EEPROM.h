@@ -0,0 +1,53 @@
+/**
+ * @file EEPROM.h
+ * @brief In-memory EEPROM for the host Arduino shim (1 KB, erased to 0xFF like a new Uno).
+ */
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @class EEPROMClass
+ * @brief Byte-addressable storage that also counts writes for wear checks.
+ */
+class EEPROMClass {
+public:
+    enum { SIZE = 1024 };
+
+    EEPROMClass() { erase(); }
+
+    uint8_t read(int address) const { return cells[address]; }
+    void write(int address, uint8_t value) { cells[address] = value; writes[address]++; }
+    void update(int address, uint8_t value) { if (cells[address] != value) write(address, value); }
+    uint16_t length() const { return SIZE; }
+
+    template <class T> T& get(int address, T& value) const {
+        memcpy(&value, cells + address, sizeof(T));
+        return value;
+    }
+
+    template <class T> const T& put(int address, const T& value) {
+        const uint8_t* bytes = (const uint8_t*)&value;
+        for (size_t i = 0; i < sizeof(T); i++) update(address + (int)i, bytes[i]);
+        return value;
+    }
+
+    /// Resets every cell to 0xFF and clears the write counters.
+    void erase() {
+        memset(cells, 0xFF, sizeof(cells));
+        memset(writes, 0, sizeof(writes));
+    }
+
+    /// @return Number of writes to one cell since erase().
+    uint32_t writeCount(int address) const { return writes[address]; }
+
+private:
+    uint8_t cells[SIZE];
+    uint32_t writes[SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,69 @@
+/**
+ * @file tournament.cpp
+ * @brief Headless self-play tournament of the firmware AI (see Tournament.h).
+ *
+ * Plays every X/O pairing of ai, minimax, heuristic and random, prints
+ * win/draw/loss rates, game lengths and the cells each side chose, and the
+ * overall games per second. The games the AI lost are counted separately,
+ * so an AI change can be checked at scale before the board is flashed.
+ * Usage: tournament [games per pairing] [threads] [seed]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include "Tournament.h"
+
+/**
+ * @brief Prints a cell histogram as percentages in board order.
+ * @param label Row label.
+ * @param counts Count per cell.
+ */
+void printCells(const char* label, const uint64_t counts[9]) {
+    uint64_t total = 0;
+    for (int cell = 0; cell < 9; cell++) total += counts[cell];
+    std::printf("    %-8s", label);
+    for (int cell = 0; cell < 9; cell++) {
+        std::printf(" %5.1f", total > 0 ? 100.0 * counts[cell] / total : 0.0);
+    }
+    std::printf("\n");
+}
+
+/**
+ * @brief Main function of the tournament.
+ * @param argc Number of arguments.
+ * @param argv Optional games per pairing, thread count and seed.
+ * @return 0.
+ */
+int main(int argc, char* argv[]) {
+    uint64_t games = argc > 1 ? std::strtoull(argv[1], NULL, 10) : 100000;
+    unsigned threads = argc > 2 ? (unsigned)std::atoi(argv[2]) : 0;
+    uint64_t seed = argc > 3 ? std::strtoull(argv[3], NULL, 10) : 2425;
+
+    Tournament tournament(threads);
+    std::printf("threads=%u games per pairing=%llu seed=%llu\n",
+        tournament.threadCount(), (unsigned long long)games, (unsigned long long)seed);
+    tournament.run(games, seed);
+
+    std::printf("%-10s %-10s %8s %8s %8s %8s\n", "X", "O", "X win%", "draw%", "O win%", "moves");
+    uint64_t aiLosses = 0;
+    for (int x = 0; x < PLAYER_KINDS; x++) {
+        for (int o = 0; o < PLAYER_KINDS; o++) {
+            const MatchTally& t = tournament.result((PlayerKind)x, (PlayerKind)o);
+            double n = t.games > 0 ? (double)t.games : 1.0;
+            uint64_t moves = 0;
+            for (int length = 0; length < 10; length++) moves += length * t.lengths[length];
+            std::printf("%-10s %-10s %8.2f %8.2f %8.2f %8.2f\n", PLAYER_NAMES[x], PLAYER_NAMES[o],
+                100.0 * t.xWins / n, 100.0 * t.draws / n, 100.0 * t.oWins / n, moves / n);
+            printCells("opening", t.openings);
+            printCells("X cells", t.moves[0]);
+            printCells("O cells", t.moves[1]);
+            if (x == PLAYER_AI && o != PLAYER_AI) aiLosses += t.oWins;
+            if (o == PLAYER_AI && x != PLAYER_AI) aiLosses += t.xWins;
+        }
+    }
+    double seconds = tournament.seconds();
+    std::printf("%llu games in %.3f s: %.0f games/s\n", (unsigned long long)tournament.totalGames(),
+        seconds, seconds > 0 ? tournament.totalGames() / seconds : 0.0);
+    std::printf("AI losses: %llu\n", (unsigned long long)aiLosses);
+    return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file virtual_arduino.cpp
+ * @brief Runs the firmware (task3.ino) behind a pseudo-terminal (Linux/macOS).
+ *
+ * The client, or lib/host/serial_latency, opens the printed pty (or the
+ * symlink given on the command line) like a real Arduino port. Bytes are
+ * paced at the chosen baud rate, 10 bits per byte, in both directions, and
+ * the firmware sees the Uno's 64-byte buffers: received bytes the sketch has
+ * not read yet are dropped when the RX buffer is full, and loop() stalls
+ * while the TX buffer is full, as a blocking Serial.print() would.
+ * The line runs at the rate the sketch passed to Serial.begin(), changes
+ * included (see Link.h); the baud argument overrides the one of setup().
+ * Bytes sent while the client's port (the pty's termios speed) is at
+ * another rate arrive garbled, as on a real UART. Above the optional
+ * maximum clean rate about one byte in NOISE_ODDS gets a flipped bit, like
+ * a cable that does not carry the higher rates.
+ * Usage: virtual_arduino [baud, 0 = unpaced] [symlink] [max clean baud]
+ */
+
+#include "task3.ino"
+#include "SerialPort.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+/// Size of the Uno's serial RX and TX buffers.
+const size_t UART_BUFFER = 64;
+
+/// One byte in NOISE_ODDS is corrupted above the maximum clean rate.
+const unsigned NOISE_ODDS = 50;
+
+typedef std::chrono::steady_clock Clock;
+
+/// Cleared by SIGINT/SIGTERM.
+volatile sig_atomic_t running = 1;
+
+void stopRunning(int) { running = 0; }
+
+/**
+ * @brief Time one byte takes on the line, 10 bits.
+ * @param baud Line rate, 0 for no pacing.
+ */
+Clock::duration byteTime(unsigned long baud) {
+    return baud > 0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(10000000000ULL / baud))
+        : Clock::duration::zero();
+}
+
+/**
+ * @brief What a receiver at the wrong rate makes of a byte: never a newline
+ * or printable text, like the framing errors a real UART reads.
+ */
+uint8_t garble(uint8_t byte) { return (uint8_t)(0x80 | (byte * 7 + 3)); }
+
+/**
+ * @return The rate the client set on its end of the pty, 0 if unknown.
+ */
+unsigned long clientBaud(int slave) {
+    termios settings;
+    if (tcgetattr(slave, &settings) != 0) return 0;
+    return PosixSerialPort::toBaud(cfgetospeed(&settings));
+}
+
+/**
+ * @brief Main function of the simulator.
+ * @param argc Number of arguments.
+ * @param argv Optional baud rate and symlink path.
+ * @return 0 on a clean stop, 1 if the pty cannot be created.
+ */
+int main(int argc, char* argv[]) {
+    unsigned long baud = argc > 1 ? strtoul(argv[1], NULL, 10) : 9600;
+    const char* link = argc > 2 ? argv[2] : NULL;
+    unsigned long cleanBaud = argc > 3 ? strtoul(argv[3], NULL, 10) : 0;
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        std::perror("posix_openpt");
+        return 1;
+    }
+    const char* slaveName = ptsname(master);
+    // Keep the slave open in raw mode: no echo or newline translation before
+    // the client opens it, and no EIO on the master when the client closes it.
+    int slave = open(slaveName, O_RDWR | O_NOCTTY);
+    termios settings;
+    if (slave < 0 || tcgetattr(slave, &settings) != 0) {
+        std::perror(slaveName);
+        return 1;
+    }
+    cfmakeraw(&settings);
+    if (baud > 0) {
+        cfsetispeed(&settings, PosixSerialPort::toSpeed(baud));
+        cfsetospeed(&settings, PosixSerialPort::toSpeed(baud));
+    }
+    tcsetattr(slave, TCSANOW, &settings);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    if (link != NULL) {
+        unlink(link);
+        if (symlink(slaveName, link) != 0) std::perror(link);
+    }
+    std::signal(SIGINT, stopRunning);
+    std::signal(SIGTERM, stopRunning);
+    std::printf("virtual Arduino on %s (%lu baud", link != NULL ? link : slaveName, baud);
+    if (cleanBaud > 0) std::printf(", noisy above %lu", cleanBaud);
+    std::printf(")\n");
+    std::fflush(stdout);
+
+    /// A byte on the line and the rate it was sent at.
+    struct WireByte {
+        Clock::time_point due; // RX: when its last bit has arrived
+        uint8_t value;
+        unsigned long baud;
+    };
+    std::deque<WireByte> rxWire;                // bytes on the way in
+    std::deque<WireByte> txBuffer;              // bytes the sketch wrote, not yet on the wire
+    Clock::time_point rxFree = Clock::now();    // when the RX line is idle
+    Clock::time_point txFree = Clock::now();    // when the TX line is idle
+    unsigned long rxOverflows = 0;
+    unsigned long garbled = 0;
+    std::mt19937 noise(2425);
+
+    // Sender and receiver rates decide what arrives.
+    auto deliver = [&](uint8_t byte, unsigned long sentAt, unsigned long readAt) -> uint8_t {
+        if (baud == 0) return byte;
+        if (sentAt != readAt) {
+            garbled++;
+            return garble(byte);
+        }
+        if (cleanBaud > 0 && sentAt > cleanBaud && noise() % NOISE_ODDS == 0) {
+            garbled++;
+            return (uint8_t)(byte ^ (1 << noise() % 8));
+        }
+        return byte;
+    };
+
+    setup();
+    if (baud > 0) {
+        Serial.begin(baud);
+        Serial.beganAt = 0; // as if setup() had begun at this rate
+    }
+    unsigned long boardBaud = Serial.baudRate;
+    while (running) {
+        Clock::time_point now = Clock::now();
+
+        // Firmware: run loop() unless a blocking print would stall it. What
+        // it printed before a Serial.begin() goes out at the old rate.
+        if (txBuffer.size() < UART_BUFFER) {
+            loop();
+            size_t switchAt = Serial.beganAt;
+            std::string out = Serial.takeOutput();
+            for (size_t i = 0; i < out.size(); i++) {
+                WireByte byte = { Clock::time_point(), (uint8_t)out[i], i < switchAt ? boardBaud : Serial.baudRate };
+                txBuffer.push_back(byte);
+            }
+            boardBaud = Serial.baudRate;
+        }
+
+        // TX: one byte per byte time onto the pty.
+        unsigned long portBaud = baud > 0 && !(txBuffer.empty() && rxWire.empty()) ? clientBaud(slave) : 0;
+        now = Clock::now();
+        if (txFree < now) txFree = now;
+        while (!txBuffer.empty() && txFree <= now + byteTime(baud > 0 ? txBuffer.front().baud : 0)) {
+            uint8_t byte = deliver(txBuffer.front().value, txBuffer.front().baud, portBaud);
+            if (write(master, &byte, 1) != 1) break; // client not reading: keep it buffered
+            txFree += byteTime(baud > 0 ? txBuffer.front().baud : 0);
+            txBuffer.pop_front();
+        }
+
+        // RX: take what the client sent, deliver it when its last bit has arrived.
+        uint8_t incoming[256];
+        ssize_t count = read(master, incoming, sizeof(incoming));
+        if (count > 0 && baud > 0) portBaud = clientBaud(slave);
+        for (ssize_t i = 0; i < count; i++) {
+            if (rxFree < now) rxFree = now;
+            rxFree += byteTime(baud > 0 ? portBaud : 0);
+            WireByte byte = { rxFree, incoming[i], portBaud };
+            rxWire.push_back(byte);
+        }
+        while (!rxWire.empty() && rxWire.front().due <= now) {
+            if (Serial.available() < (int)UART_BUFFER) {
+                uint8_t byte = deliver(rxWire.front().value, rxWire.front().baud, Serial.baudRate);
+                Serial.feed(std::string(1, (char)byte));
+            } else {
+                rxOverflows++;
+            }
+            rxWire.pop_front();
+        }
+
+        // Sleep until the next byte is due when loop() cannot run, and for
+        // a millisecond when the sketch is idle.
+        int waitMs = -1;
+        if (txBuffer.size() >= UART_BUFFER) {
+            waitMs = (int)std::chrono::duration_cast<std::chrono::milliseconds>(txFree - Clock::now()).count();
+        } else if (txBuffer.empty() && rxWire.empty() && Serial.available() == 0) {
+            waitMs = 1;
+        }
+        if (waitMs >= 0) {
+            pollfd ready = { master, POLLIN, 0 };
+            poll(&ready, 1, waitMs);
+        }
+    }
+
+    if (link != NULL) unlink(link);
+    std::printf("stopped, %lu bytes lost to RX overflow, %lu garbled, board at %lu baud\n",
+        rxOverflows, garbled, (unsigned long)Serial.baudRate);
+    close(slave);
+    close(master);
+    return 0;
+}